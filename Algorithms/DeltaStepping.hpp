@@ -0,0 +1,304 @@
+#ifndef DATASTRUCTUREIMPLEMENTATIONS_DELTASTEPPING_HPP
+#define DATASTRUCTUREIMPLEMENTATIONS_DELTASTEPPING_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <barrier>
+#include <bit>
+#include <cassert>
+#include <cmath>
+#include <concepts>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "Dijkstra.hpp"
+
+namespace Algorithm::DijkstraShortestPathDistanceAlgorithm {
+
+    /** calculateMinDistancesDeltaStepping 的参数 */
+    struct DeltaSteppingOptions {
+        /** 桶的宽度 Δ, 不大于 0 时取所有边权的平均值；不是有限的数，或者在 (0, minDelta) 中时抛出 std::invalid_argument */
+        Distance delta = 0;
+
+        /** 线程数（包括调用者所在的线程），0 表示 std::thread::hardware_concurrency() */
+        size_t threadCount = 0;
+
+        /** Δ 的下限 */
+        static constexpr Distance minDelta = 1e-9;
+    };
+
+    /**
+     * 并行的 Δ-stepping 单源最短路，输入、输出和 CSR 形式的 calculateMinDistances 相同，要求所有的边权都非负。
+     *
+     * 主要思路：
+     * 按照距离把节点放进宽度为 Δ 的桶里，第 i 个桶是距离在 [iΔ, (i+1)Δ) 中的节点，从小到大逐个处理桶：
+     * 1. 并行地松弛当前桶中所有节点的轻边（w <= Δ），被改小的节点可能又落回当前桶，于是重复这一步，直到当前桶为空；
+     * 2. 这时当前桶里出现过的节点的距离都确定了，再并行地松弛它们的重边（w > Δ），重边只会把节点放进后面的桶。
+     * Δ 越小越接近 Dijkstra（每一轮能并行的节点越少），Δ 越大越接近 Bellman-Ford（重复松弛越多）。
+     *
+     * 从当前桶 c 出发的松弛最远只能到达第 c + ceil(maxWeight / Δ) 个桶，所以桶放在一个循环数组里，
+     * 只保存 [c, c + ceil(maxWeight / Δ) + 1] 这个窗口（多一个是给浮点舍入留的余量），占用的内存和距离的大小无关。
+     * Δ 相对于最大边权很小时窗口会很长，这时窗口的长度以 maxSlots 为上限，落在窗口之外的节点先记在 farEntries 里，
+     * 窗口移过去的时候再放回桶中；窗口里没有任何记录时直接跳到 farEntries 中最小的桶，不去逐个扫描空桶。
+     *
+     * 每一轮里各个线程从当前的节点列表中按块领取节点，用 CAS 把邻居的距离改小，
+     * 改小成功的邻居记在线程自己的缓冲区里；一轮结束时在 barrier 的完成函数中（单线程）把缓冲区分发进各个桶，
+     * 并且准备好下一轮的节点列表。节点列表不足一块时不值得唤醒其他线程，完成函数自己把它松弛掉，接着准备下一轮。
+     * 同一个节点在一个桶里可能被记录多次，按照"上次展开时的距离"去重。
+     */
+    template <std::unsigned_integral VertexId, std::floating_point Weight>
+    void calculateMinDistancesDeltaStepping(
+        const CompressedGraph<VertexId, Weight> &graph,
+        NodeId start,
+        std::vector<Distance> &minDist,
+        const DeltaSteppingOptions &options = DeltaSteppingOptions()
+    ) {
+        constexpr double PositiveInfinity = std::numeric_limits<double>::infinity();
+        constexpr size_t chunkSize = 64;
+        constexpr size_t maxSlots = size_t(1) << 16;
+        const size_t nVertices = graph.vertexCount();
+        assert((start < nVertices));
+
+        size_t threadCount = options.threadCount > 0 ? options.threadCount : std::thread::hardware_concurrency();
+        threadCount = std::max<size_t>(threadCount, 1);
+
+        Distance weightSum = 0;
+        Distance maxWeight = 0;
+        for (Weight weight : graph.weights) {
+            weightSum += weight;
+            maxWeight = std::max<Distance>(maxWeight, weight);
+        }
+
+        Distance delta = options.delta;
+        if (!std::isfinite(delta) || (delta > 0 && delta < DeltaSteppingOptions::minDelta)) {
+            throw std::invalid_argument("calculateMinDistancesDeltaStepping: delta must be finite and not less than DeltaSteppingOptions::minDelta");
+        }
+        if (delta <= 0) {
+            delta = graph.edgeCount() > 0 && weightSum > 0 ? weightSum / static_cast<Distance>(graph.edgeCount()) : 1.0;
+        }
+
+        std::vector<std::atomic<Distance>> dist (nVertices);
+        for (auto &d : dist) {
+            d.store(PositiveInfinity, std::memory_order_relaxed);
+        }
+        dist[start].store(0, std::memory_order_relaxed);
+
+        /** 节点上一次被展开时的距离，用来跳过桶中重复的记录 */
+        std::vector<Distance> expandedAt (nVertices, PositiveInfinity);
+
+        auto bucketOf = [delta](Distance d) {
+            // 超出 size_t 范围的桶号截断到同一个桶里，只是这个桶里的节点要多松弛几遍，结果仍然正确
+            return static_cast<size_t>(std::min(d / delta, 0x1p62));
+        };
+
+        const Distance windowBuckets = std::ceil(maxWeight / delta) + 2;
+        // 取成 2 的幂，桶号对 slotCount 取模只需要一次按位与
+        const size_t slotCount = windowBuckets < static_cast<Distance>(maxSlots) ? std::bit_ceil(static_cast<size_t>(windowBuckets)) : maxSlots;
+        const size_t slotMask = slotCount - 1;
+
+        /** 循环的桶数组，第 b 个桶（currentBucket <= b < currentBucket + slotCount）放在 slots[b & slotMask] */
+        std::vector<std::vector<NodeId>> slots (slotCount);
+        size_t currentBucket = 0;
+
+        /** slots 中的记录总数（包括重复的），为 0 时窗口是空的 */
+        size_t windowEntries = 0;
+
+        /** 桶号超出窗口的节点，以及其中最小的桶号 */
+        std::vector<NodeId> farEntries;
+        size_t farMinBucket = std::numeric_limits<size_t>::max();
+
+        // 按照节点当前的距离把它放进桶里；已经按这个距离展开过的是过时的记录，直接丢掉，所以桶号不会小于 currentBucket
+        auto place = [&](NodeId v) {
+            Distance d = dist[v].load(std::memory_order_relaxed);
+            if (expandedAt[v] == d) {
+                return;
+            }
+            size_t bucket = bucketOf(d);
+            assert((bucket >= currentBucket));
+            if (bucket - currentBucket < slotCount) {
+                slots[bucket & slotMask].push_back(v);
+                ++windowEntries;
+            } else {
+                farEntries.push_back(v);
+                farMinBucket = std::min(farMinBucket, bucket);
+            }
+        };
+
+        // 窗口移动之后，把 farEntries 中已经落进窗口的节点放回桶里
+        auto refill = [&]() {
+            std::vector<NodeId> pending;
+            pending.swap(farEntries);
+            farMinBucket = std::numeric_limits<size_t>::max();
+            for (NodeId v : pending) {
+                place(v);
+            }
+        };
+
+        slots[0].push_back(start);
+        windowEntries = 1;
+
+        /** 节点最近一次被放进 settled 时所在的桶号加一，0 表示从来没有 */
+        std::vector<size_t> settledStamp (nVertices, 0);
+
+        /** 当前桶里出现过的节点，处理完当前桶之后松弛它们的重边 */
+        std::vector<NodeId> settled;
+
+        /** 线程自己的缓冲区，各占一个缓存行，避免 push_back 写 vector 的尾指针时和相邻线程互相干扰 */
+        struct alignas(64) LocalBuffer {
+            std::vector<NodeId> nodes;
+        };
+
+        enum class Phase { Light, Heavy, Done };
+        Phase phase = Phase::Light;
+
+        /** 创建线程失败时置位，让已经启动的线程在下一次 barrier 之后退出 */
+        bool aborted = false;
+        std::vector<NodeId> frontier;
+        std::atomic<size_t> nextChunk { 0 };
+        std::vector<LocalBuffer> localBuffers (threadCount);
+
+        // 松弛 frontier[begin, end) 中节点的轻边或者重边，改小了距离的邻居记进 buffer
+        auto relax = [&](size_t begin, size_t end, bool lightPhase, std::vector<NodeId> &buffer) {
+            for (size_t i = begin; i < end; ++i) {
+                NodeId u = frontier[i];
+                Distance fromStartToU = dist[u].load(std::memory_order_relaxed);
+                for (size_t edgeIdx = graph.offsets[u]; edgeIdx < graph.offsets[u + 1]; ++edgeIdx) {
+                    Distance weight = graph.weights[edgeIdx];
+                    if ((weight <= delta) != lightPhase) {
+                        continue;
+                    }
+
+                    NodeId v = graph.targets[edgeIdx];
+                    Distance candidate = fromStartToU + weight;
+                    Distance current = dist[v].load(std::memory_order_relaxed);
+                    while (candidate < current) {
+                        if (dist[v].compare_exchange_weak(current, candidate, std::memory_order_relaxed)) {
+                            buffer.push_back(v);
+                            break;
+                        }
+                    }
+                }
+            }
+        };
+
+        // 选出下一轮的节点列表放进 frontier, 并设置 phase, 所有的桶都处理完时 phase 为 Done
+        auto selectFrontier = [&]() {
+            frontier.clear();
+            while (true) {
+                std::vector<NodeId> &slot = slots[currentBucket & slotMask];
+                if (!slot.empty()) {
+                    for (NodeId v : slot) {
+                        Distance d = dist[v].load(std::memory_order_relaxed);
+                        if (expandedAt[v] == d) {
+                            continue;
+                        }
+                        expandedAt[v] = d;
+                        frontier.push_back(v);
+                        if (settledStamp[v] != currentBucket + 1) {
+                            settledStamp[v] = currentBucket + 1;
+                            settled.push_back(v);
+                        }
+                    }
+                    windowEntries -= slot.size();
+                    slot.clear();
+                    if (!frontier.empty()) {
+                        phase = Phase::Light;
+                        return;
+                    }
+                    continue;
+                }
+
+                if (phase == Phase::Light && !settled.empty()) {
+                    frontier.swap(settled);
+                    phase = Phase::Heavy;
+                    return;
+                }
+
+                // 当前桶处理完了，移到下一个非空的桶：窗口里还有记录就在窗口里往后找（最多 slotCount 步），否则跳到 farEntries
+                settled.clear();
+                phase = Phase::Light;
+                if (windowEntries > 0) {
+                    ++currentBucket;
+                } else if (!farEntries.empty()) {
+                    currentBucket = farMinBucket;
+                } else {
+                    phase = Phase::Done;
+                    return;
+                }
+                if (farMinBucket < currentBucket + slotCount) {
+                    refill();
+                }
+            }
+        };
+
+        // 两轮之间单线程执行：分发缓冲区，选出下一轮的节点列表，太短的列表就地处理掉
+        auto schedule = [&]() noexcept {
+            if (aborted) {
+                phase = Phase::Done;
+                return;
+            }
+            while (true) {
+                for (auto &buffer : localBuffers) {
+                    for (NodeId v : buffer.nodes) {
+                        place(v);
+                    }
+                    buffer.nodes.clear();
+                }
+
+                selectFrontier();
+                nextChunk.store(0, std::memory_order_relaxed);
+                if (phase == Phase::Done || (threadCount > 1 && frontier.size() >= chunkSize)) {
+                    return;
+                }
+                relax(0, frontier.size(), phase == Phase::Light, localBuffers[0].nodes);
+            }
+        };
+
+        std::barrier sync (static_cast<std::ptrdiff_t>(threadCount), schedule);
+        auto worker = [&](size_t threadIdx) {
+            std::vector<NodeId> &buffer = localBuffers[threadIdx].nodes;
+            while (true) {
+                sync.arrive_and_wait();
+                if (phase == Phase::Done) {
+                    return;
+                }
+
+                const bool lightPhase = phase == Phase::Light;
+                while (true) {
+                    size_t begin = nextChunk.fetch_add(chunkSize, std::memory_order_relaxed);
+                    if (begin >= frontier.size()) {
+                        break;
+                    }
+                    relax(begin, std::min(begin + chunkSize, frontier.size()), lightPhase, buffer);
+                }
+            }
+        };
+
+        {
+            // jthread 析构时自动 join. 中途创建线程失败时，已经启动的线程都停在第一个 barrier 上，
+            // 由当前线程替没有启动的线程（和它自己）到达，让它们看到 Done 退出，然后再把异常抛出去
+            std::vector<std::jthread> workers;
+            try {
+                for (size_t t = 1; t < threadCount; ++t) {
+                    workers.emplace_back(worker, t);
+                }
+            } catch (...) {
+                aborted = true;
+                for (size_t t = workers.size(); t < threadCount; ++t) {
+                    sync.arrive_and_drop();
+                }
+                throw;
+            }
+            worker(0);
+        }
+
+        minDist.resize(nVertices);
+        for (size_t v = 0; v < nVertices; ++v) {
+            minDist[v] = dist[v].load(std::memory_order_relaxed);
+        }
+    }
+
+}
+
+#endif //DATASTRUCTUREIMPLEMENTATIONS_DELTASTEPPING_HPP
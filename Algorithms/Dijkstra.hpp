@@ -6,11 +6,21 @@
 #define DATASTRUCTUREIMPLEMENTATIONS_DIJKSTRA_HPP
 
 #include <unordered_map>
-#include <unordered_set>
 #include <limits>
-#include <queue>
 #include <memory>
 #include <fstream>
+#include <algorithm>
+#include <numeric>
+#include <utility>
+#include <vector>
+#include <bit>
+#include <cassert>
+#include <concepts>
+#include <cstdint>
+#include "../DataStructures/Heap.hpp"
+#include "../DataStructures/DaryHeap.hpp"
+#include "../DataStructures/AddressableHeap.hpp"
+#include "../DataStructures/RadixHeap.hpp"
 
 namespace Algorithm {
     namespace DijkstraShortestPathDistanceAlgorithm {
@@ -37,6 +47,78 @@ namespace Algorithm {
         /** 距离矩阵 */
         using DistanceMatrix = std::unordered_map<NodeId, Connections>;
 
+        /**
+         * 压缩稀疏行（CSR）形式的有向图，是 DistanceMatrix 的紧凑版本：
+         * 节点 v 的出边是 targets 和 weights 中下标在 [offsets[v], offsets[v + 1]) 范围内的那一段，
+         * 同一个节点的出边按目标节点的 id 升序排列。遍历邻居只是顺序地读两个数组，没有哈希查找也没有指针跳转。
+         *
+         * 节点 id 直接就是行号，范围是 [0, vertexCount()), 没有出现过的 id 是一个没有出边的孤立节点。
+         * VertexId 可以用 uint32_t, Weight 可以用 float, 这样每条边只占 8 个字节，
+         * 而 DistanceMatrix 每条边是一个哈希表节点（再加上桶数组），通常要 40 个字节以上。
+         * 权值用 Weight 存储，累加距离时仍然用 Distance.
+         */
+        template <std::unsigned_integral VertexId = NodeId, std::floating_point Weight = Distance>
+        struct CompressedGraph {
+            using VertexIdType = VertexId;
+            using WeightType = Weight;
+
+            /** 长度为 vertexCount() + 1, offsets[0] = 0, offsets[vertexCount()] = edgeCount() */
+            std::vector<size_t> offsets;
+
+            /** 所有边的目标节点，按照起点分段存放 */
+            std::vector<VertexId> targets;
+
+            /** 和 targets 一一对应的边权 */
+            std::vector<Weight> weights;
+
+            /** 节点个数 */
+            [[nodiscard]] size_t vertexCount() const {
+                return this->offsets.empty() ? 0 : this->offsets.size() - 1;
+            }
+
+            /** 边的条数 */
+            [[nodiscard]] size_t edgeCount() const {
+                return this->targets.size();
+            }
+
+            /** 节点 v 的出度 */
+            [[nodiscard]] size_t outDegree(NodeId v) const {
+                return this->offsets[v + 1] - this->offsets[v];
+            }
+
+            /** 三个数组占用的字节数 */
+            [[nodiscard]] size_t memoryBytes() const {
+                return this->offsets.capacity() * sizeof(size_t)
+                    + this->targets.capacity() * sizeof(VertexId)
+                    + this->weights.capacity() * sizeof(Weight);
+            }
+
+            /** 把所有的边反向之后得到的图（反向图），双向搜索中从终点出发的那一侧在它上面进行 */
+            [[nodiscard]] CompressedGraph reversed() const {
+                const size_t nVertices = this->vertexCount();
+                CompressedGraph result;
+                result.offsets.assign(nVertices + 1, 0);
+                for (VertexId to : this->targets) {
+                    ++result.offsets[static_cast<size_t>(to) + 1];
+                }
+                std::partial_sum(result.offsets.begin(), result.offsets.end(), result.offsets.begin());
+
+                // 按起点的顺序把边分发到各自目标节点的行里，每一行仍然按（新的）目标节点的 id 升序排列
+                result.targets.resize(this->edgeCount());
+                result.weights.resize(this->edgeCount());
+                std::vector<size_t> cursors (result.offsets.begin(), result.offsets.end() - 1);
+                for (size_t from = 0; from < nVertices; ++from) {
+                    for (size_t edgeIdx = this->offsets[from]; edgeIdx < this->offsets[from + 1]; ++edgeIdx) {
+                        size_t slot = cursors[this->targets[edgeIdx]]++;
+                        result.targets[slot] = static_cast<VertexId>(from);
+                        result.weights[slot] = this->weights[edgeIdx];
+                    }
+                }
+
+                return result;
+            }
+        };
+
         /** 有向图构造器 */
         class DirectedGraphBuilder {
         public:
@@ -69,6 +151,51 @@ namespace Algorithm {
                 return std::make_unique<DistanceMatrix>(this->adjacency);
             }
 
+            /**
+             * 把暂存区中的图转换成 CSR 形式导出，然后清空暂存区（大图没有必要同时保留两份）。
+             * 节点的个数是最大的节点 id 加一，所以节点 id 应该是比较稠密的（例如从 0 开始编号）。
+             */
+            template <std::unsigned_integral VertexId = NodeId, std::floating_point Weight = Distance>
+            CompressedGraph<VertexId, Weight> finalize() {
+                CompressedGraph<VertexId, Weight> graph;
+                if (this->adjacency.empty()) {
+                    graph.offsets.assign(1, 0);
+                    return graph;
+                }
+
+                NodeId maxNodeId = 0;
+                for (const auto &pair : this->adjacency) {
+                    maxNodeId = std::max(maxNodeId, pair.first);
+                }
+                assert((maxNodeId <= std::numeric_limits<VertexId>::max()));
+
+                // 先数出每个节点的出度，前缀和就是每一行的起始位置
+                const size_t nVertices = maxNodeId + 1;
+                graph.offsets.assign(nVertices + 1, 0);
+                for (const auto &pair : this->adjacency) {
+                    graph.offsets[pair.first + 1] = pair.second.size();
+                }
+                std::partial_sum(graph.offsets.begin(), graph.offsets.end(), graph.offsets.begin());
+
+                const size_t nEdges = graph.offsets[nVertices];
+                graph.targets.resize(nEdges);
+                graph.weights.resize(nEdges);
+                std::vector<std::pair<NodeId, Distance>> row;
+                for (const auto &pair : this->adjacency) {
+                    row.assign(pair.second.begin(), pair.second.end());
+                    std::sort(row.begin(), row.end());
+                    size_t edgeIdx = graph.offsets[pair.first];
+                    for (const auto &[to, weight] : row) {
+                        graph.targets[edgeIdx] = static_cast<VertexId>(to);
+                        graph.weights[edgeIdx] = static_cast<Weight>(weight);
+                        ++edgeIdx;
+                    }
+                }
+
+                this->adjacency.clear();
+                return graph;
+            }
+
         private:
             DistanceMatrix adjacency;
         };
@@ -146,6 +273,161 @@ namespace Algorithm {
             };
         }
 
+        /**
+         * 最短距离算法可选的优先队列策略需要满足的接口：
+         * push(节点, 距离) 表示该节点的距离被改成了更小的值（可能是第一次入队，也可能是更新），
+         * topNode() / topDistance() 查看距离最小的一项，pop() 出队。
+         * 不支持修改的策略把 push 实现为再插入一项，过时的项出队时由算法跳过；支持修改的策略直接更新原来的项。
+         */
+        template <typename QueuePolicy>
+        concept MinDistanceQueuePolicy = requires(QueuePolicy queue, NodeId nodeId, Distance d) {
+            queue.push(nodeId, d);
+            queue.pop();
+            { queue.empty() } -> std::convertible_to<bool>;
+            { queue.topNode() } -> std::convertible_to<NodeId>;
+            { queue.topDistance() } -> std::convertible_to<Distance>;
+        };
+
+        /** 基于二叉堆 Heap 的队列策略，push 总是插入新的一项（惰性删除），这是默认的策略 */
+        class HeapQueuePolicy {
+        public:
+            void push(NodeId nodeId, Distance d) {
+                this->heap.emplace(d, nodeId);
+            }
+
+            void pop() {
+                this->heap.pop();
+            }
+
+            [[nodiscard]] bool empty() const {
+                return this->heap.empty();
+            }
+
+            [[nodiscard]] NodeId topNode() const {
+                return this->heap.topRef().second;
+            }
+
+            [[nodiscard]] Distance topDistance() const {
+                return this->heap.topRef().first;
+            }
+
+        private:
+            Heap<std::pair<Distance, NodeId>, std::greater<>> heap;
+        };
+
+        /** 基于 d 叉堆 DaryHeap 的队列策略，同样是惰性删除，层数更少，适合队列很长的大图 */
+        template <size_t D = 4>
+        class DaryHeapQueuePolicy {
+        public:
+            void push(NodeId nodeId, Distance d) {
+                this->heap.insert(std::pair<Distance, NodeId> { d, nodeId });
+            }
+
+            void pop() {
+                this->heap.pop();
+            }
+
+            [[nodiscard]] bool empty() const {
+                return this->heap.empty();
+            }
+
+            [[nodiscard]] NodeId topNode() const {
+                return this->heap.top().second;
+            }
+
+            [[nodiscard]] Distance topDistance() const {
+                return this->heap.top().first;
+            }
+
+        private:
+            DaryHeap<std::pair<Distance, NodeId>, D, std::greater<>> heap;
+        };
+
+        /**
+         * 基于可寻址堆 AddressableHeap 的队列策略：每个节点在队列中至多一项，距离被改小时原地 increaseKey,
+         * 所以队列长度不超过节点数，也不会有过时的项。nVertices 是节点个数的提示，用来预留句柄表。
+         */
+        class AddressableHeapQueuePolicy {
+        public:
+            explicit AddressableHeapQueuePolicy(size_t nVertices = 0) : heap(), handles(nVertices, noHandle) { }
+
+            void push(NodeId nodeId, Distance d) {
+                if (nodeId >= this->handles.size()) {
+                    this->handles.resize(nodeId + 1, noHandle);
+                }
+
+                // 句柄在出队之后可能被别的节点复用，所以还要核对句柄指向的是不是这个节点
+                Handle handle = this->handles[nodeId];
+                if (handle != noHandle && this->heap.contains(handle) && this->heap.get(handle).second == nodeId) {
+                    this->heap.increaseKey(handle, std::pair<Distance, NodeId> { d, nodeId });
+                    return;
+                }
+
+                this->handles[nodeId] = this->heap.insert(std::pair<Distance, NodeId> { d, nodeId });
+            }
+
+            void pop() {
+                this->heap.pop();
+            }
+
+            [[nodiscard]] bool empty() const {
+                return this->heap.empty();
+            }
+
+            [[nodiscard]] NodeId topNode() const {
+                return this->heap.get(this->heap.topHandle()).second;
+            }
+
+            [[nodiscard]] Distance topDistance() const {
+                return this->heap.get(this->heap.topHandle()).first;
+            }
+
+        private:
+            using Heap = AddressableHeap<std::pair<Distance, NodeId>, std::greater<>>;
+            using Handle = Heap::Handle;
+
+            static constexpr Handle noHandle = std::numeric_limits<Handle>::max();
+
+            Heap heap;
+
+            /** 节点 -> 它最近一次入队时拿到的句柄 */
+            std::vector<Handle> handles;
+        };
+
+        /**
+         * 基于基数堆的队列策略。
+         * Dijkstra 出队的距离是单调不减的，并且非负 double 的 IEEE 754 位模式按无符号整数比较时和数值的大小顺序一致，
+         * 所以可以直接把距离的位模式当作基数堆的 key, 入队、出队都不需要做浮点比较。要求所有的边权都非负。
+         */
+        class RadixHeapQueuePolicy {
+        public:
+            void push(NodeId nodeId, Distance d) {
+                assert((d >= 0));
+                // -0.0 的符号位是 1, 先把它规范成 +0.0
+                Distance normalized = d == 0 ? 0.0 : d;
+                this->heap.insert(std::bit_cast<uint64_t>(normalized), nodeId);
+            }
+
+            void pop() {
+                this->heap.pop();
+            }
+
+            [[nodiscard]] bool empty() const {
+                return this->heap.empty();
+            }
+
+            [[nodiscard]] NodeId topNode() const {
+                return this->heap.topValue();
+            }
+
+            [[nodiscard]] Distance topDistance() const {
+                return std::bit_cast<Distance>(this->heap.topKey());
+            }
+
+        private:
+            RadixHeap<uint64_t, NodeId> heap;
+        };
+
         /**
          * 功能说明：
          * 此函数接受一个邻接矩阵形式编码的图 g, 设 g 有 V 个节点，且 V >= 1.
@@ -160,41 +442,267 @@ namespace Algorithm {
          * 4. start 到其它节点的最短距离用 minDist[start] 存储，
          *    譬如说：minDist[start][4] = 5 则表示 start 到节点 4 的最短距离是 5;
          * 5. 使用时，可以默认构造一个空的 DistanceMatrix 对象，然后让 minDist 引用这个对象即可；
+         * 6. 候选节点由传入的优先队列 queue 来调度，见 MinDistanceQueuePolicy.
+         *
+         * 这是真正的 Dijkstra 算法：每次取出距离最小的节点，它的距离从此确定，每个节点只被展开一次；
+         * 只有当邻居的距离被改小时才把它入队，过时的队列项在出队时直接跳过。要求所有的边权都非负。
          */
+        template <MinDistanceQueuePolicy QueuePolicy>
         void calculateMinDistances(
             DistanceMatrix &distance,
             NodeId start,
-            DistanceMatrix &minDist
+            DistanceMatrix &minDist,
+            QueuePolicy &&queue
         ) {
             constexpr double PositiveInfinity = std::numeric_limits<double>::infinity();
+            Connections &minDistFromStart = minDist[start];
             for (const auto &pair : distance) {
                 NodeId nodeId = pair.first;
-                minDist[start][nodeId] = PositiveInfinity;
+                minDistFromStart[nodeId] = PositiveInfinity;
             }
-            minDist[start][start] = 0;
+            minDistFromStart[start] = 0;
+
+            queue.push(start, 0);
+            while (!queue.empty()) {
+                NodeId currentNodeId = queue.topNode();
+                Distance currentDistance = queue.topDistance();
+                queue.pop();
+                if (currentDistance > minDistFromStart[currentNodeId]) {
+                    continue;
+                }
 
-            std::queue<NodeId> candidates;
-            candidates.push(start);
-            std::unordered_set<NodeId> traversed;
-            while (!candidates.empty()) {
-                NodeId currentNodeId = candidates.front();
-                candidates.pop();
-                traversed.insert(currentNodeId);
                 for (const auto &adjacency : distance[currentNodeId]) {
                     NodeId adjacencyNodeId = adjacency.first;
-                    Distance fromCurrentToAdjacency = adjacency.second;
-                    if (!traversed.contains(adjacencyNodeId)) {
-                        candidates.push(adjacencyNodeId);
+                    Distance fromStartToAdjViaCurrentNode = currentDistance + adjacency.second;
+                    Distance &fromStartToAdj = minDistFromStart[adjacencyNodeId];
+                    if (fromStartToAdj > fromStartToAdjViaCurrentNode) {
+                        fromStartToAdj = fromStartToAdjViaCurrentNode;
+                        queue.push(adjacencyNodeId, fromStartToAdjViaCurrentNode);
                     }
+                }
+            }
+        }
 
-                    Distance fromStartToAdj = minDist[start][adjacencyNodeId];
-                    Distance fromStartToAdjViaCurrentNode = minDist[start][currentNodeId] + fromCurrentToAdjacency;
+        /** 功能和参数的说明同上，使用默认的 HeapQueuePolicy */
+        void calculateMinDistances(
+            DistanceMatrix &distance,
+            NodeId start,
+            DistanceMatrix &minDist
+        ) {
+            calculateMinDistances(distance, start, minDist, HeapQueuePolicy());
+        }
+
+        /** 表示"没有目标节点"：一直算到所有可达的节点的距离都确定为止 */
+        constexpr NodeId NoTarget = std::numeric_limits<NodeId>::max();
+
+        /**
+         * 单目标的最短距离：在 CSR 形式的图上从 start 开始做 Dijkstra, 一旦 target 出队（它的距离确定了）就立即停止，
+         * 返回 start 到 target 的最短距离，到不了时返回正无穷大。target 为 NoTarget 时算出所有节点的距离。
+         * minDist 会被重新设为 graph.vertexCount() 的长度：已经出队的节点的值是最终的最短距离，其余的只是上界。
+         * 提前停止时 queue 中可能还留有一些项。要求所有的边权都非负。
+         */
+        template <std::unsigned_integral VertexId, std::floating_point Weight, MinDistanceQueuePolicy QueuePolicy>
+        Distance calculateMinDistance(
+            const CompressedGraph<VertexId, Weight> &graph,
+            NodeId start,
+            NodeId target,
+            std::vector<Distance> &minDist,
+            QueuePolicy &&queue
+        ) {
+            constexpr double PositiveInfinity = std::numeric_limits<double>::infinity();
+            assert((start < graph.vertexCount()));
+            assert((target == NoTarget || target < graph.vertexCount()));
+            minDist.assign(graph.vertexCount(), PositiveInfinity);
+            minDist[start] = 0;
 
+            queue.push(start, 0);
+            while (!queue.empty()) {
+                NodeId currentNodeId = queue.topNode();
+                Distance currentDistance = queue.topDistance();
+                queue.pop();
+                if (currentDistance > minDist[currentNodeId]) {
+                    continue;
+                }
+                if (currentNodeId == target) {
+                    return currentDistance;
+                }
+
+                for (size_t edgeIdx = graph.offsets[currentNodeId]; edgeIdx < graph.offsets[currentNodeId + 1]; ++edgeIdx) {
+                    NodeId adjacencyNodeId = graph.targets[edgeIdx];
+                    Distance fromStartToAdjViaCurrentNode = currentDistance + graph.weights[edgeIdx];
+                    Distance &fromStartToAdj = minDist[adjacencyNodeId];
                     if (fromStartToAdj > fromStartToAdjViaCurrentNode) {
-                        minDist[start][adjacencyNodeId] = fromStartToAdjViaCurrentNode;
+                        fromStartToAdj = fromStartToAdjViaCurrentNode;
+                        queue.push(adjacencyNodeId, fromStartToAdjViaCurrentNode);
                     }
                 }
             }
+
+            return target == NoTarget ? PositiveInfinity : minDist[target];
+        }
+
+        /** 单目标的最短距离，使用默认的 HeapQueuePolicy */
+        template <std::unsigned_integral VertexId, std::floating_point Weight>
+        Distance calculateMinDistance(const CompressedGraph<VertexId, Weight> &graph, NodeId start, NodeId target) {
+            std::vector<Distance> minDist;
+            return calculateMinDistance(graph, start, target, minDist, HeapQueuePolicy());
+        }
+
+        /**
+         * 功能同上，输入是 CSR 形式的图，输出是稠密的 minDist: minDist[v] 是 start 到节点 v 的最短距离，
+         * 到不了的节点是正无穷大，minDist 会被重新设为 graph.vertexCount() 的长度。
+         * 候选节点由传入的优先队列 queue 来调度，要求所有的边权都非负。
+         */
+        template <std::unsigned_integral VertexId, std::floating_point Weight, MinDistanceQueuePolicy QueuePolicy>
+        void calculateMinDistances(
+            const CompressedGraph<VertexId, Weight> &graph,
+            NodeId start,
+            std::vector<Distance> &minDist,
+            QueuePolicy &&queue
+        ) {
+            calculateMinDistance(graph, start, NoTarget, minDist, std::forward<QueuePolicy>(queue));
+        }
+
+        /** 功能同上，使用默认的 HeapQueuePolicy */
+        template <std::unsigned_integral VertexId, std::floating_point Weight>
+        void calculateMinDistances(
+            const CompressedGraph<VertexId, Weight> &graph,
+            NodeId start,
+            std::vector<Distance> &minDist
+        ) {
+            calculateMinDistances(graph, start, minDist, HeapQueuePolicy());
+        }
+
+        /**
+         * 双向 Dijkstra: 从 start 在 graph 上、从 target 在反向图 reversed（即 graph.reversed()）上同时搜索，
+         * 每一步扩展两侧中队首距离较小的那一侧，返回 start 到 target 的最短距离，到不了时返回正无穷大。
+         *
+         * 主要思路：
+         * 松弛边 (u, v) 时如果 v 已经被另一侧到达过，那么 forwardDist[u] + w + backwardDist[v] 就是一条 start 到 target 的路径的长度，
+         * 记下其中最短的 best. 当两侧的队首距离之和不小于 best 时，不可能再有更短的路径了，立即停止。
+         * 两个搜索圈大约各自只有单向搜索的半径的一半，在路网这样的近似平面的图上扩展的节点数少得多。
+         * 要求所有的边权都非负。
+         */
+        template <std::unsigned_integral VertexId, std::floating_point Weight, MinDistanceQueuePolicy QueuePolicy = HeapQueuePolicy>
+        Distance calculateMinDistanceBidirectional(
+            const CompressedGraph<VertexId, Weight> &graph,
+            const CompressedGraph<VertexId, Weight> &reversed,
+            NodeId start,
+            NodeId target,
+            QueuePolicy forwardQueue = QueuePolicy(),
+            QueuePolicy backwardQueue = QueuePolicy()
+        ) {
+            constexpr double PositiveInfinity = std::numeric_limits<double>::infinity();
+            assert((graph.vertexCount() == reversed.vertexCount()));
+            assert((start < graph.vertexCount() && target < graph.vertexCount()));
+            if (start == target) {
+                return 0;
+            }
+
+            std::vector<Distance> forwardDist (graph.vertexCount(), PositiveInfinity);
+            std::vector<Distance> backwardDist (graph.vertexCount(), PositiveInfinity);
+            forwardDist[start] = 0;
+            backwardDist[target] = 0;
+            forwardQueue.push(start, 0);
+            backwardQueue.push(target, 0);
+            Distance best = PositiveInfinity;
+
+            // 从 queue 中取出一个节点并在 side 上展开，otherDist 是另一侧的距离
+            auto expand = [&best](
+                const CompressedGraph<VertexId, Weight> &side,
+                QueuePolicy &queue,
+                std::vector<Distance> &dist,
+                const std::vector<Distance> &otherDist
+            ) {
+                NodeId currentNodeId = queue.topNode();
+                Distance currentDistance = queue.topDistance();
+                queue.pop();
+                if (currentDistance > dist[currentNodeId]) {
+                    return;
+                }
+
+                for (size_t edgeIdx = side.offsets[currentNodeId]; edgeIdx < side.offsets[currentNodeId + 1]; ++edgeIdx) {
+                    NodeId adjacencyNodeId = side.targets[edgeIdx];
+                    Distance viaCurrentNode = currentDistance + side.weights[edgeIdx];
+                    if (dist[adjacencyNodeId] > viaCurrentNode) {
+                        dist[adjacencyNodeId] = viaCurrentNode;
+                        queue.push(adjacencyNodeId, viaCurrentNode);
+                    }
+                    best = std::min(best, viaCurrentNode + otherDist[adjacencyNodeId]);
+                }
+            };
+
+            while (!forwardQueue.empty() && !backwardQueue.empty()) {
+                Distance forwardTop = forwardQueue.topDistance();
+                Distance backwardTop = backwardQueue.topDistance();
+                if (forwardTop + backwardTop >= best) {
+                    break;
+                }
+
+                if (forwardTop <= backwardTop) {
+                    expand(graph, forwardQueue, forwardDist, backwardDist);
+                } else {
+                    expand(reversed, backwardQueue, backwardDist, forwardDist);
+                }
+            }
+
+            return best;
+        }
+
+        /**
+         * A* 搜索：和单目标的 Dijkstra 相同，只是队列按照 g(v) + heuristic(v) 排序，
+         * 其中 g(v) 是目前已知的 start 到 v 的距离，heuristic(v) 是调用方给出的 v 到 target 的距离的估计，
+         * 例如根据节点坐标算出的直线距离。target 出队时立即停止，返回 start 到 target 的最短距离，到不了时返回正无穷大。
+         *
+         * heuristic 必须是可采纳的（不超过真实的距离），否则结果可能不是最短的。
+         * 如果它还是一致的（对每条边 (u, v) 都有 heuristic(u) <= w + heuristic(v)），每个节点只展开一次；
+         * 不一致时节点的距离可能在展开之后被改小，这时它会被重新入队，结果仍然正确。
+         * RadixHeapQueuePolicy 要求出队的值单调不减，只能配合一致的 heuristic 使用。
+         */
+        template <
+            std::unsigned_integral VertexId,
+            std::floating_point Weight,
+            std::invocable<NodeId> Heuristic,
+            MinDistanceQueuePolicy QueuePolicy = HeapQueuePolicy
+        >
+        Distance calculateMinDistanceAStar(
+            const CompressedGraph<VertexId, Weight> &graph,
+            NodeId start,
+            NodeId target,
+            Heuristic &&heuristic,
+            QueuePolicy &&queue = QueuePolicy()
+        ) {
+            constexpr double PositiveInfinity = std::numeric_limits<double>::infinity();
+            assert((start < graph.vertexCount() && target < graph.vertexCount()));
+            std::vector<Distance> minDist (graph.vertexCount(), PositiveInfinity);
+            minDist[start] = 0;
+
+            queue.push(start, static_cast<Distance>(heuristic(start)));
+            while (!queue.empty()) {
+                NodeId currentNodeId = queue.topNode();
+                Distance currentEstimate = queue.topDistance();
+                queue.pop();
+                if (currentNodeId == target) {
+                    return minDist[target];
+                }
+
+                const Distance currentDistance = minDist[currentNodeId];
+                if (currentEstimate > currentDistance + static_cast<Distance>(heuristic(currentNodeId))) {
+                    continue;
+                }
+
+                for (size_t edgeIdx = graph.offsets[currentNodeId]; edgeIdx < graph.offsets[currentNodeId + 1]; ++edgeIdx) {
+                    NodeId adjacencyNodeId = graph.targets[edgeIdx];
+                    Distance fromStartToAdjViaCurrentNode = currentDistance + graph.weights[edgeIdx];
+                    Distance &fromStartToAdj = minDist[adjacencyNodeId];
+                    if (fromStartToAdj > fromStartToAdjViaCurrentNode) {
+                        fromStartToAdj = fromStartToAdjViaCurrentNode;
+                        queue.push(adjacencyNodeId, fromStartToAdjViaCurrentNode + static_cast<Distance>(heuristic(adjacencyNodeId)));
+                    }
+                }
+            }
+
+            return PositiveInfinity;
         }
     }
 }
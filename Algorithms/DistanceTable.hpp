@@ -0,0 +1,179 @@
+#ifndef DATASTRUCTUREIMPLEMENTATIONS_DISTANCETABLE_HPP
+#define DATASTRUCTUREIMPLEMENTATIONS_DISTANCETABLE_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <concepts>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "Dijkstra.hpp"
+#include "../DataStructures/Heap.hpp"
+
+namespace Algorithm::DijkstraShortestPathDistanceAlgorithm {
+
+    /**
+     * 多对多的距离表：给定一组起点 sources 和一组终点 targets, 算出每个起点到每个终点的最短距离，
+     * 结果按行优先写进一个扁平的 std::vector<Distance>: table[i * targets.size() + j] 是 sources[i] 到 targets[j] 的距离，
+     * 到不了时是正无穷大。要求所有的边权都非负。
+     *
+     * 主要思路：
+     * 每个起点做一次单源 Dijkstra, 所有的终点都出队之后就提前停止，多个起点由多个线程并行地处理。
+     * 每个线程有一份自己的暂存区（距离数组、堆、时间戳），在多次计算之间复用，不再为每个起点重新分配和清零：
+     * 每开始一个起点就把线程的时间戳加一，stamps[v] 不等于当前时间戳的节点视为距离是正无穷大，
+     * 所以一次单源搜索的开销只和它实际访问到的节点个数有关，和整张图的大小无关。
+     *
+     * 引擎持有 graph 的引用，graph 必须比引擎活得更久。compute 不能在多个线程中同时调用。
+     */
+    template <std::unsigned_integral VertexId, std::floating_point Weight>
+    class DistanceTableEngine {
+    public:
+        /** threadCount 为 0 时取 std::thread::hardware_concurrency() */
+        explicit DistanceTableEngine(const CompressedGraph<VertexId, Weight> &_graph, size_t threadCount = 0)
+        : graph(_graph), scratches(), targetStamps(_graph.vertexCount(), 0), targetEpoch(0) {
+            if (threadCount == 0) {
+                threadCount = std::thread::hardware_concurrency();
+            }
+            this->scratches.resize(std::max<size_t>(threadCount, 1));
+        }
+
+        /** 不允许复制 */
+        DistanceTableEngine(const DistanceTableEngine &rhs) = delete;
+
+        /** 算出 sources x targets 的距离表，写进 table（会被重新设为 sources.size() * targets.size() 的长度） */
+        void compute(const std::vector<NodeId> &sources, const std::vector<NodeId> &targets, std::vector<Distance> &table) {
+            table.resize(sources.size() * targets.size());
+            if (sources.empty() || targets.empty()) {
+                return;
+            }
+
+            // 标记终点并数出其中不同的节点个数，搜索时出队的不同终点达到这个数就可以停止了
+            const uint32_t epoch = nextEpoch(this->targetEpoch, this->targetStamps);
+            size_t distinctTargets = 0;
+            for (NodeId target : targets) {
+                assert((target < this->graph.vertexCount()));
+                if (this->targetStamps[target] != epoch) {
+                    this->targetStamps[target] = epoch;
+                    ++distinctTargets;
+                }
+            }
+
+            const size_t threadCount = std::min(this->scratches.size(), sources.size());
+            std::atomic<size_t> nextSource { 0 };
+            auto worker = [&, epoch, distinctTargets](size_t threadIdx) {
+                Scratch &scratch = this->scratches[threadIdx];
+                while (true) {
+                    size_t sourceIdx = nextSource.fetch_add(1, std::memory_order_relaxed);
+                    if (sourceIdx >= sources.size()) {
+                        return;
+                    }
+
+                    this->search(scratch, sources[sourceIdx], epoch, distinctTargets);
+                    Distance *row = table.data() + sourceIdx * targets.size();
+                    for (size_t j = 0; j < targets.size(); ++j) {
+                        row[j] = scratch.distanceTo(targets[j]);
+                    }
+                }
+            };
+
+            // jthread 析构时自动 join, 中途创建线程失败抛出异常时，已经启动的线程也会先被等待结束
+            std::vector<std::jthread> workers;
+            for (size_t t = 1; t < threadCount; ++t) {
+                workers.emplace_back(worker, t);
+            }
+            worker(0);
+        }
+
+        /** 同上，直接返回距离表 */
+        [[nodiscard]] std::vector<Distance> compute(const std::vector<NodeId> &sources, const std::vector<NodeId> &targets) {
+            std::vector<Distance> table;
+            this->compute(sources, targets, table);
+            return table;
+        }
+
+        /** 并行的线程数，也就是暂存区的份数 */
+        [[nodiscard]] size_t threadCount() const {
+            return this->scratches.size();
+        }
+
+    private:
+        /**
+         * 一个线程的暂存区，第一次使用时按照图的大小分配，之后一直复用。
+         * 对齐到缓存行，堆每次 push / pop 都要写 vector 的尾指针，不能和相邻线程的暂存区落在同一个缓存行里
+         */
+        struct alignas(64) Scratch {
+            std::vector<Distance> dist;
+
+            /** stamps[v] == epoch 时 dist[v] 才有效 */
+            std::vector<uint32_t> stamps;
+
+            uint32_t epoch = 0;
+
+            Heap<std::pair<Distance, NodeId>, std::greater<>> heap;
+
+            [[nodiscard]] Distance distanceTo(NodeId v) const {
+                return this->stamps[v] == this->epoch ? this->dist[v] : std::numeric_limits<Distance>::infinity();
+            }
+        };
+
+        const CompressedGraph<VertexId, Weight> &graph;
+        std::vector<Scratch> scratches;
+
+        /** targetStamps[v] == targetEpoch 表示 v 是本次 compute 的终点之一 */
+        std::vector<uint32_t> targetStamps;
+        uint32_t targetEpoch;
+
+        /** 时间戳加一，回绕到 0 时把所有的戳清零一次 */
+        static uint32_t nextEpoch(uint32_t &epoch, std::vector<uint32_t> &stamps) {
+            if (++epoch == 0) {
+                std::fill(stamps.begin(), stamps.end(), 0);
+                epoch = 1;
+            }
+            return epoch;
+        }
+
+        /** 在 scratch 上从 source 做 Dijkstra, 所有的终点都出队之后停止 */
+        void search(Scratch &scratch, NodeId source, uint32_t targetEpochNow, size_t distinctTargets) const {
+            assert((source < this->graph.vertexCount()));
+            if (scratch.stamps.size() != this->graph.vertexCount()) {
+                scratch.dist.assign(this->graph.vertexCount(), 0);
+                scratch.stamps.assign(this->graph.vertexCount(), 0);
+                scratch.epoch = 0;
+            }
+
+            const uint32_t epoch = nextEpoch(scratch.epoch, scratch.stamps);
+            scratch.heap.clear();
+            scratch.dist[source] = 0;
+            scratch.stamps[source] = epoch;
+            scratch.heap.emplace(0.0, source);
+
+            size_t settledTargets = 0;
+            while (!scratch.heap.empty()) {
+                auto [currentDistance, currentNodeId] = scratch.heap.extract();
+                if (currentDistance > scratch.dist[currentNodeId]) {
+                    continue;
+                }
+                if (this->targetStamps[currentNodeId] == targetEpochNow && ++settledTargets == distinctTargets) {
+                    return;
+                }
+
+                for (size_t edgeIdx = this->graph.offsets[currentNodeId]; edgeIdx < this->graph.offsets[currentNodeId + 1]; ++edgeIdx) {
+                    NodeId adjacencyNodeId = this->graph.targets[edgeIdx];
+                    Distance fromStartToAdjViaCurrentNode = currentDistance + this->graph.weights[edgeIdx];
+                    if (scratch.stamps[adjacencyNodeId] != epoch || scratch.dist[adjacencyNodeId] > fromStartToAdjViaCurrentNode) {
+                        scratch.stamps[adjacencyNodeId] = epoch;
+                        scratch.dist[adjacencyNodeId] = fromStartToAdjViaCurrentNode;
+                        scratch.heap.emplace(fromStartToAdjViaCurrentNode, adjacencyNodeId);
+                    }
+                }
+            }
+        }
+    };
+
+}
+
+#endif //DATASTRUCTUREIMPLEMENTATIONS_DISTANCETABLE_HPP
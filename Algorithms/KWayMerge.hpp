@@ -0,0 +1,271 @@
+#ifndef DATASTRUCTUREIMPLEMENTATIONS_KWAYMERGE_HPP
+#define DATASTRUCTUREIMPLEMENTATIONS_KWAYMERGE_HPP
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <concepts>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Algorithm::KWayMerge {
+
+    /**
+     * 归并的数据源（游标）：empty() 表示数据源已经耗尽，head() 是当前的头部元素，advance() 前进到下一个元素。
+     * 每个数据源内部必须已经按照 Compare 从小到大排好序。
+     */
+    template <typename Cursor>
+    concept MergeCursor = requires (Cursor &cursor, const Cursor &constCursor) {
+        { constCursor.empty() } -> std::convertible_to<bool>;
+        constCursor.head();
+        cursor.advance();
+    };
+
+    /** 一对迭代器 [first, last) 作为数据源，std::vector 等有序的容器都可以这样接入 */
+    template <std::input_iterator Iterator, std::sentinel_for<Iterator> Sentinel = Iterator>
+    class IteratorCursor {
+    public:
+        IteratorCursor(Iterator first, Sentinel last) : first(std::move(first)), last(std::move(last)) { }
+
+        [[nodiscard]] bool empty() const {
+            return this->first == this->last;
+        }
+
+        decltype(auto) head() const {
+            return *this->first;
+        }
+
+        void advance() {
+            ++this->first;
+        }
+
+        /** 当前位置的迭代器 */
+        const Iterator &position() const {
+            return this->first;
+        }
+
+    private:
+        Iterator first;
+        Sentinel last;
+    };
+
+    /** 单链表作为数据源，节点需要有 val 和 next 两个成员（和 LeetCode 的 ListNode 一致） */
+    template <typename Node>
+    class LinkedListCursor {
+    public:
+        explicit LinkedListCursor(Node *node) : node(node) { }
+
+        [[nodiscard]] bool empty() const {
+            return this->node == nullptr;
+        }
+
+        const auto &head() const {
+            return this->node->val;
+        }
+
+        void advance() {
+            this->node = this->node->next;
+        }
+
+        /** 当前的头部节点，归并链表时直接把它接到结果链表上，不需要复制 */
+        Node *current() const {
+            return this->node;
+        }
+
+    private:
+        Node *node;
+    };
+
+    /**
+     * 败者树（锦标赛树），k 路归并的引擎。
+     *
+     * 主要思路：
+     * k 个数据源是 k 片叶子，每个内部节点记录在这里比赛中"输掉"的那个数据源，根的上面再单独记录总的胜者，
+     * 总的胜者就是所有数据源头部中最小的那个。胜者前进一步之后，只需要沿着它的叶子到根的路径重赛一遍，
+     * 路径上每个节点比较一次，也就是每输出一个元素恰好 ceil(log2 k) 场比赛，
+     * 而不是像两两归并那样让同一个元素被反复地比较和移动。
+     *
+     * 节点上只存数据源的编号，各个数据源的头部元素放在一个连续的数组 heads 里，重赛时交换的只是编号。
+     * 叶子的个数补齐到 2 的幂，这样任何一个内部节点的左子树中的数据源编号都小于右子树中的，
+     * 头部相同时编号小的数据源获胜（归并是稳定的）就可以由挑战者来自哪一边决定，每场比赛只调用一次 compare.
+     * 耗尽的数据源（以及补齐用的空叶子）用编号 Exhausted 表示，它永远输，判断它只是一次整数比较。
+     */
+    template <MergeCursor Cursor, typename Compare = std::less<>>
+    class LoserTree {
+    public:
+        /** 头部元素的类型，heads 中存放的是它的副本，需要能够默认构造 */
+        using Key = std::remove_cvref_t<decltype(std::declval<const Cursor&>().head())>;
+
+        /** 以 cursors 为叶子建树，O(k) */
+        explicit LoserTree(std::vector<Cursor> cursors, const Compare &compare = Compare());
+
+        /** 是否所有数据源都已经耗尽 */
+        [[nodiscard]] bool empty() const;
+
+        /** 当前胜者（头部最小的数据源）的编号，不得为空 */
+        [[nodiscard]] size_t winner() const;
+
+        /** 当前胜者的游标，可以从中取出头部元素（或者链表节点） */
+        Cursor &winnerCursor();
+
+        /** 当前胜者的头部元素，即所有数据源中最小的那个，不得为空 */
+        const Key &top() const;
+
+        /** 胜者前进一步，然后沿着它的路径重赛一遍 */
+        void advanceWinner();
+
+        /** 数据源的个数 */
+        [[nodiscard]] size_t sourceCount() const;
+
+    private:
+        /** 耗尽的数据源的编号 */
+        static constexpr size_t Exhausted = std::numeric_limits<size_t>::max();
+
+        std::vector<Cursor> cursors;
+
+        /** heads[s] 是数据源 s 当前的头部，数据源耗尽之后不再有意义 */
+        std::vector<Key> heads;
+
+        /** nodes[n] 是内部节点 n 上的败者，n 从 1 开始，nodes[0] 是总的胜者；叶子 s 的编号是 s + leafCount */
+        std::vector<size_t> nodes;
+
+        /** 叶子的个数，数据源的个数向上补齐到 2 的幂 */
+        size_t leafCount;
+
+        [[no_unique_address]] Compare compare;
+
+        /** 读出数据源 source 的头部放进 heads, 返回它参赛用的编号 */
+        size_t refresh(size_t source);
+    };
+
+    template <MergeCursor Cursor, typename Compare>
+    LoserTree<Cursor, Compare>::LoserTree(std::vector<Cursor> _cursors, const Compare &_compare)
+    : cursors(std::move(_cursors)), heads(this->cursors.size()), nodes(), leafCount(std::bit_ceil(this->cursors.size())), compare(_compare) {
+        const size_t k = this->cursors.size();
+        if (k == 0) {
+            return;
+        }
+
+        // 自底向上赛一遍：winners[n] 是以 n 为根的子树中的胜者，叶子 n >= leafCount 的胜者就是数据源 n - leafCount
+        std::vector<size_t> winners (2 * this->leafCount, Exhausted);
+        for (size_t s = 0; s < k; ++s) {
+            winners[s + this->leafCount] = this->refresh(s);
+        }
+
+        this->nodes.resize(this->leafCount, Exhausted);
+        for (size_t n = this->leafCount - 1; n >= 1; --n) {
+            // 左边的编号更小，头部相同时左边获胜
+            size_t lhs = winners[2 * n];
+            size_t rhs = winners[2 * n + 1];
+            bool rhsWins = lhs == Exhausted || (rhs != Exhausted && this->compare(this->heads[rhs], this->heads[lhs]));
+            winners[n] = rhsWins ? rhs : lhs;
+            this->nodes[n] = rhsWins ? lhs : rhs;
+        }
+        this->nodes[0] = winners[1];
+    }
+
+    template <MergeCursor Cursor, typename Compare>
+    size_t LoserTree<Cursor, Compare>::refresh(size_t source) {
+        const Cursor &cursor = this->cursors[source];
+        if (cursor.empty()) {
+            return Exhausted;
+        }
+
+        this->heads[source] = cursor.head();
+        return source;
+    }
+
+    template <MergeCursor Cursor, typename Compare>
+    bool LoserTree<Cursor, Compare>::empty() const {
+        return this->nodes.empty() || this->nodes[0] == Exhausted;
+    }
+
+    template <MergeCursor Cursor, typename Compare>
+    size_t LoserTree<Cursor, Compare>::winner() const {
+        return this->nodes[0];
+    }
+
+    template <MergeCursor Cursor, typename Compare>
+    Cursor &LoserTree<Cursor, Compare>::winnerCursor() {
+        return this->cursors[this->nodes[0]];
+    }
+
+    template <MergeCursor Cursor, typename Compare>
+    const typename LoserTree<Cursor, Compare>::Key &LoserTree<Cursor, Compare>::top() const {
+        assert((!this->empty()));
+        return this->heads[this->nodes[0]];
+    }
+
+    template <MergeCursor Cursor, typename Compare>
+    void LoserTree<Cursor, Compare>::advanceWinner() {
+        const size_t source = this->nodes[0];
+        this->cursors[source].advance();
+        size_t champion = this->refresh(source);
+
+        // 胜者耗尽了：它在路径上的每一场都输，第一个遇到的正常数据源接过挑战者的位置，之后按正常的比赛继续
+        size_t child = source + this->leafCount;
+        size_t n = child / 2;
+        if (champion == Exhausted) [[unlikely]] {
+            for (; n >= 1 && champion == Exhausted; child = n, n /= 2) {
+                std::swap(this->nodes[n], champion);
+            }
+        }
+
+        // child 是挑战者进入节点 n 时经过的子节点，它是右孩子说明守擂的败者来自左边、编号更小，头部相同时守擂者获胜。
+        // 两个编号按方向排好之后只比较一次；比赛的结果本身很难预测，所以排序和交换都用异或掩码来做，不用分支
+        const Key *headsData = this->heads.data();
+        size_t *nodesData = this->nodes.data();
+        for (; n >= 1; child = n, n /= 2) {
+            const size_t stored = nodesData[n];
+            if (stored == Exhausted) {
+                continue;
+            }
+
+            const bool fromRight = child & 1;
+            const size_t orderMask = (stored ^ champion) & (size_t(0) - fromRight);
+            const size_t lhs = stored ^ orderMask;
+            const size_t rhs = champion ^ orderMask;
+            const bool storedWins = static_cast<bool>(this->compare(headsData[lhs], headsData[rhs])) != fromRight;
+            const size_t swapMask = (stored ^ champion) & (size_t(0) - storedWins);
+            nodesData[n] = stored ^ swapMask;
+            champion ^= swapMask;
+        }
+        this->nodes[0] = champion;
+    }
+
+    template <MergeCursor Cursor, typename Compare>
+    size_t LoserTree<Cursor, Compare>::sourceCount() const {
+        return this->cursors.size();
+    }
+
+    /**
+     * 把 ranges 中的每一个有序区间归并起来，依次写到 out, 返回写完之后的 out.
+     * ranges 可以是 std::vector<std::vector<T>>, 也可以是任何"区间的区间"。
+     */
+    template <std::ranges::input_range RangeOfRanges, typename OutputIt, typename Compare = std::less<>>
+    OutputIt mergeSortedRanges(RangeOfRanges &&ranges, OutputIt out, const Compare &compare = Compare()) {
+        using InnerRange = std::ranges::range_reference_t<RangeOfRanges>;
+        using Cursor = IteratorCursor<std::ranges::iterator_t<InnerRange>, std::ranges::sentinel_t<InnerRange>>;
+        std::vector<Cursor> cursors;
+        for (auto &&range : ranges) {
+            cursors.emplace_back(std::ranges::begin(range), std::ranges::end(range));
+        }
+
+        LoserTree<Cursor, Compare> tree { std::move(cursors), compare };
+        while (!tree.empty()) {
+            *out = tree.top();
+            ++out;
+            tree.advanceWinner();
+        }
+
+        return out;
+    }
+
+}
+
+#endif //DATASTRUCTUREIMPLEMENTATIONS_KWAYMERGE_HPP
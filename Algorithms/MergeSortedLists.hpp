@@ -16,7 +16,9 @@
  * };
  */
 
+#include <utility>
 #include <vector>
+#include "KWayMerge.hpp"
 
 namespace Algorithm::MergeSortedLists {
 
@@ -31,9 +33,9 @@ namespace Algorithm::MergeSortedLists {
      * 合并 K 个已排好序的链表：
      *
      * 解法思路：
-     * 1. 两层双指针，最外层那对双指针 i, j 指向 std::vector<ListNode*> lists 前后相邻两个元素（在这之前先判定 lists.size() >= 2);
-     * 2. 内层双指针一个 ListNode *lhs 指向 lists[i] 的插入位置，一个指向 lists[j] 的当前扫描位置；
-     * 3. 为了方便，可以临时建一个 ListNode dummy 对象，让 dummy.next 指向 lhs, 这样不管 lhs 是否为空，都可以方便地插入。
+     * 1. 以 K 个链表为叶子建一棵败者树（见 KWayMerge.hpp），树的胜者就是 K 个链表头部中最小的那个节点；
+     * 2. 每次把胜者的头部节点直接接到结果链表的末尾（不复制节点），然后胜者前进一步，沿着它的路径重赛一遍；
+     * 3. 每输出一个节点只需要 ceil(log2 K) 次比较，总共 O(N log K), 而两两依次合并最坏是 O(N K).
      */
     class Solution {
     public:
@@ -45,46 +47,32 @@ namespace Algorithm::MergeSortedLists {
                 return flatArray(lists);
             }
 
-
-            for (size_t di = 0; di < N-1; ++di) {
-                size_t prevIdx = N-2-di;
-                size_t currIdx = N-1-di;
-                lists[prevIdx] = mergeTwoSortedLinkedList(lists[prevIdx], lists[currIdx]);
-                lists.pop_back();
+            using Cursor = KWayMerge::LinkedListCursor<ListNode>;
+            std::vector<Cursor> cursors;
+            cursors.reserve(N);
+            for (ListNode *head : lists) {
+                cursors.emplace_back(head);
             }
 
-            return flatArray(lists);
-        }
-
-    private:
-        ListNode *mergeTwoSortedLinkedList(ListNode *prev, ListNode *curr) {
-            ListNode dummy;
-            ListNode *lhs = &dummy;
-            lhs->next = prev;
-            while (curr) {
-                if (!(lhs->next)) {
-                    lhs->next = curr;
-                    return dummy.next;
-                }
-
-                if (lhs->next && curr->val <= lhs->next->val) {
-                    auto temp = lhs->next;
-                    lhs->next = curr;
-                    curr = curr->next;
-                    lhs->next->next = temp;
-                    continue;
-                }
-
-                while (lhs && lhs->next && curr->val > lhs->next->val) {
-                    lhs = lhs->next;
-                }
+            KWayMerge::LoserTree<Cursor> tree { std::move(cursors) };
+            ListNode dummy { 0, nullptr };
+            ListNode *tail = &dummy;
+            while (!tree.empty()) {
+                // 先取出节点再前进，接到 tail 上时只改动上一个节点的 next, 不影响游标读取当前节点的 next
+                ListNode *node = tree.winnerCursor().current();
+                tail->next = node;
+                tail = node;
+                tree.advanceWinner();
             }
+            tail->next = nullptr;
 
+            lists.assign(1, dummy.next);
             return dummy.next;
         }
 
+    private:
         ListNode *flatArray(const std::vector<ListNode*> &lists) {
-            ListNode dummy;
+            ListNode dummy { 0, nullptr };
             ListNode *dummyPtr = &dummy;
             for (const auto &lst : lists) {
                 ListNode *head = lst;
@@ -0,0 +1,46 @@
+#ifndef DATASTRUCTUREIMPLEMENTATIONS_BENCHMARKUTILS_HPP
+#define DATASTRUCTUREIMPLEMENTATIONS_BENCHMARKUTILS_HPP
+
+#include <cstdint>
+#include <random>
+#include <sstream>
+#include <iomanip>
+#include <string>
+#include <vector>
+
+namespace Benchmark {
+
+    /** 生成 n 个均匀分布的伪随机整数，固定种子以便不同实现跑的是同一份数据 */
+    template <typename IntType>
+    std::vector<IntType> makeRandomIntegers(size_t n, IntType lo, IntType hi, uint64_t seed = 20221017) {
+        std::mt19937_64 engine { seed };
+        std::uniform_int_distribution<IntType> distribution { lo, hi };
+        std::vector<IntType> result;
+        result.reserve(n);
+        for (size_t i = 0; i < n; ++i) {
+            result.push_back(distribution(engine));
+        }
+
+        return result;
+    }
+
+    /** 把毫秒数格式化成字符串 */
+    std::string formatMilliseconds(double ms) {
+        std::ostringstream oss;
+        oss << std::fixed << std::setprecision(1) << ms << " ms";
+        return oss.str();
+    }
+
+    /** 把 ops 次操作耗时 ms 毫秒换算成每秒百万次操作（Mops/s） */
+    std::string formatThroughput(size_t ops, double ms) {
+        std::ostringstream oss;
+        oss << std::fixed << std::setprecision(2) << (ms > 0 ? static_cast<double>(ops) / ms / 1000.0 : 0.0) << " Mops/s";
+        return oss.str();
+    }
+
+    /** 防止编译器把测量的结果优化掉：所有基准测试把校验和写到这里 */
+    volatile uint64_t sink = 0;
+
+}
+
+#endif //DATASTRUCTUREIMPLEMENTATIONS_BENCHMARKUTILS_HPP
@@ -0,0 +1,102 @@
+#ifndef DATASTRUCTUREIMPLEMENTATIONS_BUCKETQUEUEBENCHMARK_HPP
+#define DATASTRUCTUREIMPLEMENTATIONS_BUCKETQUEUEBENCHMARK_HPP
+
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "BenchmarkUtils.hpp"
+#include "../DataStructures/Heap.hpp"
+#include "../DataStructures/BucketQueue.hpp"
+#include "../Utils/Stopwatch.hpp"
+#include "../Utils/PrintTable.hpp"
+
+namespace Benchmark::BucketQueueTrace {
+
+    /** 操作序列中的一项：insert 一个 [0, 256) 中的优先级，或者 pop（用 popMarker 表示） */
+    constexpr uint32_t popMarker = UINT32_MAX;
+
+    /**
+     * 生成操作序列：先插入 prefill 个元素，之后每一步以 insertRatio 的概率插入，否则弹出，
+     * 队列长度围绕 prefill 上下浮动，两种实现回放的是同一份序列。
+     */
+    std::vector<uint32_t> makeTrace(size_t n, size_t prefill, double insertRatio) {
+        std::mt19937_64 engine { 20221017 };
+        std::uniform_int_distribution<uint32_t> priorityDistribution { 0, 255 };
+        std::uniform_real_distribution<double> coin { 0.0, 1.0 };
+        std::vector<uint32_t> trace;
+        trace.reserve(prefill + n);
+        size_t queued = 0;
+        for (size_t i = 0; i < prefill + n; ++i) {
+            if (i < prefill || queued == 0 || coin(engine) < insertRatio) {
+                trace.push_back(priorityDistribution(engine));
+                ++queued;
+            } else {
+                trace.push_back(popMarker);
+                --queued;
+            }
+        }
+
+        return trace;
+    }
+
+    /** 回放操作序列，返回耗时，弹出的优先级之和写进 checksum 用来核对两种实现 */
+    template <typename QueueT>
+    double replay(QueueT &queue, const std::vector<uint32_t> &trace, uint64_t &checksum) {
+        checksum = 0;
+        Utils::Stopwatch stopwatch;
+        for (uint32_t op : trace) {
+            if (op == popMarker) {
+                checksum = checksum * 31 + queue.extract();
+            } else {
+                queue.insert(op);
+            }
+        }
+        double ms = stopwatch.elapsedMilliseconds();
+        queue.clear();
+        sink = sink + checksum;
+        return ms;
+    }
+
+    /**
+     * 优先级在 [0, 256) 中的操作序列，对比 BucketQueue<uint32_t, 256> 和 Heap<uint32_t>.
+     * 分别测试队列很短（常驻 64 个）和很长（常驻 1,000,000 个）两种情况，后者 Heap 的缓存缺失更多。
+     * n 是操作个数，为 0 时默认 n = 20,000,000.
+     */
+    void run(size_t n) {
+        if (n == 0) {
+            n = 20'000'000;
+        }
+
+        std::vector<std::string> indexCol;
+        std::vector<std::string> headers { "Heap", "BucketQueue", "speedup" };
+        std::vector<std::vector<std::string>> cells;
+        for (size_t prefill : { size_t(64), size_t(1'000'000) }) {
+            auto trace = makeTrace(n, prefill, 0.5);
+            uint64_t heapChecksum = 0;
+            uint64_t bucketChecksum = 0;
+
+            Heap<uint32_t> heap;
+            double heapMs = replay(heap, trace, heapChecksum);
+            BucketQueue<uint32_t, 256> bucketQueue;
+            double bucketMs = replay(bucketQueue, trace, bucketChecksum);
+            if (heapChecksum != bucketChecksum) {
+                std::cout << "checksum mismatch with " << prefill << " queued\n";
+            }
+
+            indexCol.push_back(std::to_string(prefill) + " queued");
+            cells.push_back({
+                formatThroughput(trace.size(), heapMs),
+                formatThroughput(trace.size(), bucketMs),
+                std::to_string(heapMs / bucketMs).substr(0, 4) + "x"
+            });
+        }
+
+        std::cout << n << " mixed insert / pop operations, priorities in [0, 256)\n";
+        Utils::PrintTable(indexCol, headers, cells);
+    }
+
+}
+
+#endif //DATASTRUCTUREIMPLEMENTATIONS_BUCKETQUEUEBENCHMARK_HPP
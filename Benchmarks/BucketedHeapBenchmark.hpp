@@ -0,0 +1,89 @@
+#ifndef DATASTRUCTUREIMPLEMENTATIONS_BUCKETEDHEAPBENCHMARK_HPP
+#define DATASTRUCTUREIMPLEMENTATIONS_BUCKETEDHEAPBENCHMARK_HPP
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "BenchmarkUtils.hpp"
+#include "../DataStructures/Heap.hpp"
+#include "../DataStructures/BucketedHeap.hpp"
+#include "../Utils/Stopwatch.hpp"
+#include "../Utils/PrintTable.hpp"
+
+namespace Benchmark::ApproximateHeap {
+
+    /** 插入全部 keys 再全部弹出，返回每秒操作数（插入和弹出各算一次） */
+    template <typename HeapT>
+    std::string insertThenDrain(HeapT &heap, const std::vector<uint32_t> &keys) {
+        Utils::Stopwatch stopwatch;
+        for (uint32_t key : keys) {
+            heap.insert(key);
+        }
+        uint64_t checksum = 0;
+        while (!heap.empty()) {
+            checksum += heap.extract();
+        }
+        double ms = stopwatch.elapsedMilliseconds();
+        sink = sink + checksum;
+        return formatThroughput(keys.size() * 2, ms);
+    }
+
+    /**
+     * 保持模型（hold model）：先放进 prefill 个元素，然后反复"弹出一个、插入一个比它低一点的新元素"，
+     * 这是调度器、负载削减中队列长度大致稳定时的典型用法。
+     */
+    template <typename HeapT>
+    std::string hold(HeapT &heap, const std::vector<uint32_t> &keys, size_t prefill) {
+        for (size_t i = 0; i < prefill; ++i) {
+            heap.insert(keys[i]);
+        }
+
+        Utils::Stopwatch stopwatch;
+        uint64_t checksum = 0;
+        for (size_t i = prefill; i < keys.size(); ++i) {
+            uint32_t key = heap.extract();
+            checksum += key;
+            heap.insert(key > keys[i] % 4096 ? key - keys[i] % 4096 : 0);
+        }
+        double ms = stopwatch.elapsedMilliseconds();
+        heap.clear();
+        sink = sink + checksum;
+        return formatThroughput((keys.size() - prefill) * 2, ms);
+    }
+
+    /**
+     * 对比精确的 Heap 和不同桶宽的 BucketedHeap, 桶宽就是弹出顺序的误差上界。
+     * 优先级是 [0, 2^24) 中的随机整数。n 为 0 时默认 n = 4,000,000.
+     */
+    void run(size_t n) {
+        if (n == 0) {
+            n = 4'000'000;
+        }
+
+        auto keys = makeRandomIntegers<uint32_t>(n, 0, (1u << 24) - 1, 1);
+        size_t prefill = n / 4;
+
+        std::vector<std::string> indexCol;
+        std::vector<std::string> headers { "insert + drain", "hold" };
+        std::vector<std::vector<std::string>> cells;
+
+        {
+            Heap<uint32_t> heap;
+            indexCol.push_back("Heap (exact)");
+            cells.push_back({ insertThenDrain(heap, keys), hold(heap, keys, prefill) });
+        }
+
+        for (double width : { 1.0, 64.0, 4096.0, 65536.0, 1048576.0 }) {
+            BucketedHeap<uint32_t> heap { width };
+            indexCol.push_back("BucketedHeap, width = " + std::to_string(static_cast<uint64_t>(width)));
+            cells.push_back({ insertThenDrain(heap, keys), hold(heap, keys, prefill) });
+        }
+
+        std::cout << n << " random priorities in [0, 2^24), hold model with " << prefill << " queued elements\n";
+        Utils::PrintTable(indexCol, headers, cells);
+    }
+
+}
+
+#endif //DATASTRUCTUREIMPLEMENTATIONS_BUCKETEDHEAPBENCHMARK_HPP
@@ -0,0 +1,91 @@
+#ifndef DATASTRUCTUREIMPLEMENTATIONS_DARYHEAPBENCHMARK_HPP
+#define DATASTRUCTUREIMPLEMENTATIONS_DARYHEAPBENCHMARK_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "BenchmarkUtils.hpp"
+#include "../DataStructures/Heap.hpp"
+#include "../DataStructures/DaryHeap.hpp"
+#include "../Utils/Stopwatch.hpp"
+#include "../Utils/PrintTable.hpp"
+
+namespace Benchmark::DaryHeapArity {
+
+    /** 32 字节的记录 */
+    struct Record32 {
+        uint64_t key;
+        uint64_t payload[3];
+
+        bool operator<(const Record32 &rhs) const {
+            return this->key < rhs.key;
+        }
+    };
+
+    /** 全部插入再全部弹出，返回 {插入耗时, 弹出耗时} */
+    template <typename HeapT, typename MakeT>
+    std::pair<double, double> pushThenPop(const std::vector<uint64_t> &keys, const MakeT &make) {
+        HeapT heap;
+        Utils::Stopwatch stopwatch;
+        for (const auto &key : keys) {
+            heap.insert(make(key));
+        }
+        double pushMs = stopwatch.elapsedMilliseconds();
+
+        stopwatch.reset();
+        uint64_t checksum = 0;
+        while (!heap.empty()) {
+            checksum += static_cast<uint64_t>(heap.size());
+            heap.pop();
+        }
+        double popMs = stopwatch.elapsedMilliseconds();
+        sink = sink + checksum;
+        return { pushMs, popMs };
+    }
+
+    template <typename T, typename MakeT>
+    void addRows(
+        const std::string &typeName,
+        const std::vector<uint64_t> &keys,
+        const MakeT &make,
+        std::vector<std::string> &indexCol,
+        std::vector<std::vector<std::string>> &cells
+    ) {
+        auto addRow = [&](const std::string &name, std::pair<double, double> result) {
+            indexCol.push_back(typeName + ", " + name);
+            cells.push_back({
+                formatMilliseconds(result.first), formatThroughput(keys.size(), result.first),
+                formatMilliseconds(result.second), formatThroughput(keys.size(), result.second)
+            });
+        };
+
+        addRow("Heap", pushThenPop<Heap<T>>(keys, make));
+        addRow("D = 2", pushThenPop<DaryHeap<T, 2>>(keys, make));
+        addRow("D = 4", pushThenPop<DaryHeap<T, 4>>(keys, make));
+        addRow("D = 8", pushThenPop<DaryHeap<T, 8>>(keys, make));
+    }
+
+    /**
+     * 比较不同的分叉数 D 对插入和弹出的影响，负载分别是 int 和 32 字节的记录。
+     * n 为 0 时默认 n = 10,000,000.
+     */
+    void run(size_t n) {
+        if (n == 0) {
+            n = 10'000'000;
+        }
+
+        auto keys = makeRandomIntegers<uint64_t>(n, 0, UINT32_MAX);
+
+        std::vector<std::string> indexCol;
+        std::vector<std::string> headers { "push", "push rate", "pop", "pop rate" };
+        std::vector<std::vector<std::string>> cells;
+        addRows<int>("int", keys, [](uint64_t key) { return static_cast<int>(key); }, indexCol, cells);
+        addRows<Record32>("32-byte record", keys, [](uint64_t key) { return Record32 { key, {} }; }, indexCol, cells);
+
+        std::cout << "n = " << n << "\n";
+        Utils::PrintTable(indexCol, headers, cells);
+    }
+
+}
+
+#endif //DATASTRUCTUREIMPLEMENTATIONS_DARYHEAPBENCHMARK_HPP
@@ -0,0 +1,127 @@
+#ifndef DATASTRUCTUREIMPLEMENTATIONS_DELTASTEPPINGBENCHMARK_HPP
+#define DATASTRUCTUREIMPLEMENTATIONS_DELTASTEPPINGBENCHMARK_HPP
+
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "BenchmarkUtils.hpp"
+#include "DijkstraBenchmark.hpp"
+#include "../Algorithms/Dijkstra.hpp"
+#include "../Algorithms/DeltaStepping.hpp"
+#include "../Utils/Stopwatch.hpp"
+#include "../Utils/PrintTable.hpp"
+
+namespace Benchmark::DeltaSteppingScaling {
+
+    using namespace Algorithm::DijkstraShortestPathDistanceAlgorithm;
+
+    /** 两组距离是否一致，加法顺序不同，允许一点点浮点误差 */
+    bool sameDistances(const std::vector<Distance> &lhs, const std::vector<Distance> &rhs) {
+        if (lhs.size() != rhs.size()) {
+            return false;
+        }
+        for (size_t v = 0; v < lhs.size(); ++v) {
+            if (lhs[v] != rhs[v] && std::abs(lhs[v] - rhs[v]) > 1e-9 * std::abs(lhs[v])) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    /**
+     * 在 SampleData/tinyEWD 上用各种线程数跑 Δ-stepping, 和顺序的 calculateMinDistances 的结果逐个节点核对。
+     * 需要在仓库的根目录下运行，找不到数据文件时跳过。
+     */
+    void checkTinyEWD(const std::vector<size_t> &threadCounts) {
+        if (!std::ifstream("SampleData/tinyEWD/tinyEWD.txt").is_open()) {
+            std::cout << "SampleData/tinyEWD not found, run from the repository root to check against it\n";
+            return;
+        }
+
+        TestCase testCase = loadTestCase();
+        DistanceMatrix &adjacency = *testCase.graphDescriptor.adjacency;
+        DirectedGraphBuilder builder;
+        for (const auto &[from, connections] : adjacency) {
+            for (const auto &[to, weight] : connections) {
+                builder.connect(from, to, weight);
+            }
+        }
+        auto graph = builder.finalize();
+
+        DistanceMatrix sequential;
+        calculateMinDistances(adjacency, 0, sequential);
+        std::vector<Distance> expected (graph.vertexCount());
+        for (const auto &[nodeId, d] : sequential[0]) {
+            expected[nodeId] = d;
+        }
+
+        size_t failures = 0;
+        for (size_t threadCount : threadCounts) {
+            for (Distance delta : { 0.0, 0.1, 0.5, 10.0 }) {
+                std::vector<Distance> minDist;
+                calculateMinDistancesDeltaStepping(graph, 0, minDist, DeltaSteppingOptions { delta, threadCount });
+                failures += sameDistances(expected, minDist) ? 0 : 1;
+            }
+        }
+        std::cout << "tinyEWD: " << (failures == 0 ? "all runs match calculateMinDistances" : std::to_string(failures) + " runs differ") << "\n";
+    }
+
+    /**
+     * 1 到 32 个线程下 Δ-stepping 在随机图和网格图上的耗时，Δ 取边权的平均值，
+     * 第一行是顺序的 Dijkstra（HeapQueuePolicy）作为对照，每一次的结果都和它核对。
+     * n 是节点个数，为 0 时默认 n = 1,000,000.
+     */
+    void run(size_t n) {
+        if (n == 0) {
+            n = 1'000'000;
+        }
+
+        const std::vector<size_t> threadCounts { 1, 2, 4, 8, 16, 32 };
+        checkTinyEWD(threadCounts);
+
+        const size_t side = static_cast<size_t>(std::sqrt(static_cast<double>(n)));
+        std::vector<std::pair<std::string, DijkstraQueue::Graph>> graphs;
+        graphs.emplace_back("random", DijkstraQueue::makeRandomGraph(n));
+        graphs.emplace_back("grid", DijkstraQueue::makeGridGraph(side));
+
+        std::vector<std::vector<Distance>> expected;
+        std::vector<std::string> indexCol { "Dijkstra" };
+        std::vector<std::string> headers;
+        std::vector<std::vector<std::string>> cells (threadCounts.size() + 1);
+        for (const auto &[name, graph] : graphs) {
+            headers.push_back(name);
+            headers.push_back("speedup");
+            std::vector<Distance> minDist;
+            Utils::Stopwatch stopwatch;
+            calculateMinDistances(graph, 0, minDist);
+            double dijkstraMs = stopwatch.elapsedMilliseconds();
+            cells[0].push_back(formatMilliseconds(dijkstraMs));
+            cells[0].push_back("1.00x");
+
+            for (size_t i = 0; i < threadCounts.size(); ++i) {
+                std::vector<Distance> parallelMinDist;
+                stopwatch.reset();
+                calculateMinDistancesDeltaStepping(graph, 0, parallelMinDist, DeltaSteppingOptions { 0, threadCounts[i] });
+                double ms = stopwatch.elapsedMilliseconds();
+                if (!sameDistances(minDist, parallelMinDist)) {
+                    std::cout << "mismatch on the " << name << " graph with " << threadCounts[i] << " threads\n";
+                }
+                cells[i + 1].push_back(formatMilliseconds(ms));
+                cells[i + 1].push_back(std::to_string(dijkstraMs / ms).substr(0, 4) + "x");
+            }
+        }
+        for (size_t threadCount : threadCounts) {
+            indexCol.push_back("delta-stepping, " + std::to_string(threadCount) + " threads");
+        }
+
+        std::cout << n << " vertices, hardware threads: " << std::thread::hardware_concurrency() << "\n";
+        Utils::PrintTable(indexCol, headers, cells);
+    }
+
+}
+
+#endif //DATASTRUCTUREIMPLEMENTATIONS_DELTASTEPPINGBENCHMARK_HPP
@@ -0,0 +1,164 @@
+#ifndef DATASTRUCTUREIMPLEMENTATIONS_DIJKSTRABENCHMARK_HPP
+#define DATASTRUCTUREIMPLEMENTATIONS_DIJKSTRABENCHMARK_HPP
+
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "BenchmarkUtils.hpp"
+#include "../Algorithms/Dijkstra.hpp"
+#include "../Utils/Stopwatch.hpp"
+#include "../Utils/PrintTable.hpp"
+
+namespace Benchmark::DijkstraQueue {
+
+    using namespace Algorithm::DijkstraShortestPathDistanceAlgorithm;
+
+    using Graph = CompressedGraph<uint32_t, float>;
+
+    /** n 个节点的随机有向图，每个节点 degree 条出边，边权在 [1, 100] 中均匀分布 */
+    Graph makeRandomGraph(size_t n, size_t degree = 4, uint64_t seed = 20221017) {
+        std::mt19937_64 engine { seed };
+        std::uniform_int_distribution<uint32_t> vertexDistribution { 0, static_cast<uint32_t>(n - 1) };
+        std::uniform_real_distribution<float> weightDistribution { 1.0f, 100.0f };
+        Graph graph;
+        graph.offsets.resize(n + 1);
+        graph.targets.reserve(n * degree);
+        graph.weights.reserve(n * degree);
+        for (size_t v = 0; v < n; ++v) {
+            graph.offsets[v] = v * degree;
+            for (size_t i = 0; i < degree; ++i) {
+                graph.targets.push_back(vertexDistribution(engine));
+                graph.weights.push_back(weightDistribution(engine));
+            }
+        }
+        graph.offsets[n] = n * degree;
+
+        return graph;
+    }
+
+    /** side x side 的网格，每个格子和上下左右的邻居双向相连，边权在 [1, 100] 中均匀分布，类似路网 */
+    Graph makeGridGraph(size_t side, uint64_t seed = 20221017) {
+        std::mt19937_64 engine { seed };
+        std::uniform_real_distribution<float> weightDistribution { 1.0f, 100.0f };
+        Graph graph;
+        graph.offsets.reserve(side * side + 1);
+        graph.offsets.push_back(0);
+        for (size_t row = 0; row < side; ++row) {
+            for (size_t col = 0; col < side; ++col) {
+                auto connect = [&](size_t r, size_t c) {
+                    graph.targets.push_back(static_cast<uint32_t>(r * side + c));
+                    graph.weights.push_back(weightDistribution(engine));
+                };
+                if (row > 0) {
+                    connect(row - 1, col);
+                }
+                if (col > 0) {
+                    connect(row, col - 1);
+                }
+                if (col + 1 < side) {
+                    connect(row, col + 1);
+                }
+                if (row + 1 < side) {
+                    connect(row + 1, col);
+                }
+                graph.offsets.push_back(graph.targets.size());
+            }
+        }
+
+        return graph;
+    }
+
+    /** 所有有限距离之和，用来核对不同的队列策略 */
+    double checksumOf(const std::vector<Distance> &minDist) {
+        double checksum = 0;
+        for (Distance d : minDist) {
+            if (std::isfinite(d)) {
+                checksum += d;
+            }
+        }
+
+        return checksum;
+    }
+
+    /** 从节点 0 出发算出所有节点的距离，返回耗时 */
+    template <typename QueuePolicy>
+    double measureFull(const Graph &graph, QueuePolicy queue, double &checksum) {
+        std::vector<Distance> minDist;
+        Utils::Stopwatch stopwatch;
+        calculateMinDistances(graph, 0, minDist, queue);
+        double ms = stopwatch.elapsedMilliseconds();
+        checksum = checksumOf(minDist);
+        sink = sink + static_cast<uint64_t>(checksum);
+        return ms;
+    }
+
+    /** queries 次随机的单目标查询（提前停止），返回平均每次的耗时 */
+    double measureSingleTarget(const Graph &graph, size_t queries) {
+        std::mt19937_64 engine { 20221017 };
+        std::uniform_int_distribution<NodeId> vertexDistribution { 0, graph.vertexCount() - 1 };
+        std::vector<Distance> minDist;
+        double totalMs = 0;
+        for (size_t i = 0; i < queries; ++i) {
+            NodeId start = vertexDistribution(engine);
+            NodeId target = vertexDistribution(engine);
+            Utils::Stopwatch stopwatch;
+            Distance d = calculateMinDistance(graph, start, target, minDist, HeapQueuePolicy());
+            totalMs += stopwatch.elapsedMilliseconds();
+            sink = sink + static_cast<uint64_t>(std::isfinite(d) ? d : 0);
+        }
+
+        return totalMs / static_cast<double>(queries);
+    }
+
+    /**
+     * 在随机图（每个节点 4 条出边）和网格图上跑单源最短路，对比不同的队列策略，
+     * 最后一列是随机的起点、终点之间的单目标查询（目标出队即停止）平均每次的耗时。
+     * n 是节点个数，为 0 时默认 n = 1,000,000.
+     */
+    void run(size_t n) {
+        if (n == 0) {
+            n = 1'000'000;
+        }
+
+        const size_t side = static_cast<size_t>(std::sqrt(static_cast<double>(n)));
+        std::vector<std::pair<std::string, Graph>> graphs;
+        graphs.emplace_back("random", makeRandomGraph(n));
+        graphs.emplace_back("grid", makeGridGraph(side));
+
+        std::vector<std::string> indexCol;
+        std::vector<std::string> headers { "Heap", "DaryHeap<4>", "AddressableHeap", "RadixHeap", "Heap, 1 target" };
+        std::vector<std::vector<std::string>> cells;
+        for (const auto &[name, graph] : graphs) {
+            double heapChecksum = 0;
+            double daryChecksum = 0;
+            double addressableChecksum = 0;
+            double radixChecksum = 0;
+            double heapMs = measureFull(graph, HeapQueuePolicy(), heapChecksum);
+            double daryMs = measureFull(graph, DaryHeapQueuePolicy<4>(), daryChecksum);
+            double addressableMs = measureFull(graph, AddressableHeapQueuePolicy(graph.vertexCount()), addressableChecksum);
+            double radixMs = measureFull(graph, RadixHeapQueuePolicy(), radixChecksum);
+            double singleTargetMs = measureSingleTarget(graph, 20);
+            if (heapChecksum != daryChecksum || heapChecksum != addressableChecksum || heapChecksum != radixChecksum) {
+                std::cout << "checksum mismatch on the " << name << " graph\n";
+            }
+
+            indexCol.push_back(name + " (" + std::to_string(graph.vertexCount()) + " V, " + std::to_string(graph.edgeCount()) + " E)");
+            cells.push_back({
+                formatMilliseconds(heapMs),
+                formatMilliseconds(daryMs),
+                formatMilliseconds(addressableMs),
+                formatMilliseconds(radixMs),
+                formatMilliseconds(singleTargetMs)
+            });
+        }
+
+        std::cout << "single-source shortest paths on CSR graphs (uint32_t ids, float weights)\n";
+        Utils::PrintTable(indexCol, headers, cells);
+    }
+
+}
+
+#endif //DATASTRUCTUREIMPLEMENTATIONS_DIJKSTRABENCHMARK_HPP
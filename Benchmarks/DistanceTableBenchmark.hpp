@@ -0,0 +1,104 @@
+#ifndef DATASTRUCTUREIMPLEMENTATIONS_DISTANCETABLEBENCHMARK_HPP
+#define DATASTRUCTUREIMPLEMENTATIONS_DISTANCETABLEBENCHMARK_HPP
+
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "BenchmarkUtils.hpp"
+#include "DijkstraBenchmark.hpp"
+#include "../Algorithms/Dijkstra.hpp"
+#include "../Algorithms/DistanceTable.hpp"
+#include "../Utils/Stopwatch.hpp"
+#include "../Utils/PrintTable.hpp"
+
+namespace Benchmark::DistanceTable {
+
+    using namespace Algorithm::DijkstraShortestPathDistanceAlgorithm;
+
+    /**
+     * 1000 x 1000 的距离表（起点、终点都是随机挑选的节点），图是 n 个节点的网格，对比：
+     * - 每个起点调用一次 DistanceMatrix 版的 calculateMinDistances（太慢，只跑前 10 个起点再按比例估算）；
+     * - 每个起点调用一次 CSR 版的 calculateMinDistances, 每次重新分配距离数组；
+     * - DistanceTableEngine, 1 个线程和全部硬件线程。
+     * n 为 0 时默认 n = 40,000.
+     */
+    void run(size_t n) {
+        if (n == 0) {
+            n = 40'000;
+        }
+
+        const size_t side = static_cast<size_t>(std::sqrt(static_cast<double>(n)));
+        const DijkstraQueue::Graph graph = DijkstraQueue::makeGridGraph(side);
+        const size_t tableSide = 1000;
+        std::mt19937_64 engine { 20221017 };
+        std::uniform_int_distribution<NodeId> vertexDistribution { 0, graph.vertexCount() - 1 };
+        std::vector<NodeId> sources;
+        std::vector<NodeId> targets;
+        for (size_t i = 0; i < tableSide; ++i) {
+            sources.push_back(vertexDistribution(engine));
+            targets.push_back(vertexDistribution(engine));
+        }
+
+        // DistanceMatrix 版本：先把图转成哈希表的形式
+        DistanceMatrix adjacency;
+        for (size_t from = 0; from < graph.vertexCount(); ++from) {
+            Connections &connections = adjacency[from];
+            for (size_t edgeIdx = graph.offsets[from]; edgeIdx < graph.offsets[from + 1]; ++edgeIdx) {
+                connections[graph.targets[edgeIdx]] = graph.weights[edgeIdx];
+            }
+        }
+        const size_t sampledSources = 10;
+        Utils::Stopwatch stopwatch;
+        for (size_t i = 0; i < sampledSources; ++i) {
+            DistanceMatrix minDist;
+            calculateMinDistances(adjacency, sources[i], minDist);
+            sink = sink + static_cast<uint64_t>(minDist[sources[i]][targets[0]]);
+        }
+        double hashMapMs = stopwatch.elapsedMilliseconds() * static_cast<double>(tableSide) / sampledSources;
+
+        std::vector<Distance> expected (tableSide * tableSide);
+        stopwatch.reset();
+        for (size_t i = 0; i < tableSide; ++i) {
+            std::vector<Distance> minDist;
+            calculateMinDistances(graph, sources[i], minDist);
+            for (size_t j = 0; j < tableSide; ++j) {
+                expected[i * tableSide + j] = minDist[targets[j]];
+            }
+        }
+        double perSourceMs = stopwatch.elapsedMilliseconds();
+
+        std::vector<std::string> indexCol { "DistanceMatrix, one call per source (est.)", "CSR, one call per source" };
+        std::vector<std::vector<std::string>> cells {
+            { formatMilliseconds(hashMapMs), formatMilliseconds(hashMapMs / tableSide) },
+            { formatMilliseconds(perSourceMs), formatMilliseconds(perSourceMs / tableSide) },
+        };
+        // 单核的机器上硬件线程数就是 1, 不要把同一行测两遍
+        std::vector<size_t> threadCounts { 1 };
+        if (size_t hardwareThreads = std::thread::hardware_concurrency(); hardwareThreads > 1) {
+            threadCounts.push_back(hardwareThreads);
+        }
+        for (size_t threadCount : threadCounts) {
+            DistanceTableEngine tableEngine { graph, threadCount };
+            std::vector<Distance> table;
+            stopwatch.reset();
+            tableEngine.compute(sources, targets, table);
+            double engineMs = stopwatch.elapsedMilliseconds();
+            if (table != expected) {
+                std::cout << "table mismatch with " << threadCount << " threads\n";
+            }
+
+            indexCol.push_back("DistanceTableEngine, " + std::to_string(threadCount) + " threads");
+            cells.push_back({ formatMilliseconds(engineMs), formatMilliseconds(engineMs / tableSide) });
+        }
+
+        std::cout << tableSide << " x " << tableSide << " distance table on a " << side << " x " << side << " grid\n";
+        std::vector<std::string> headers { "total", "per source" };
+        Utils::PrintTable(indexCol, headers, cells);
+    }
+
+}
+
+#endif //DATASTRUCTUREIMPLEMENTATIONS_DISTANCETABLEBENCHMARK_HPP
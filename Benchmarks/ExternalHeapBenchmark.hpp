@@ -0,0 +1,83 @@
+#ifndef DATASTRUCTUREIMPLEMENTATIONS_EXTERNALHEAPBENCHMARK_HPP
+#define DATASTRUCTUREIMPLEMENTATIONS_EXTERNALHEAPBENCHMARK_HPP
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "BenchmarkUtils.hpp"
+#include "../DataStructures/Heap.hpp"
+#include "../DataStructures/ExternalHeap.hpp"
+#include "../Utils/Stopwatch.hpp"
+#include "../Utils/PrintTable.hpp"
+
+namespace Benchmark::ExternalHeapSpill {
+
+    /** 插入全部 keys 再全部弹出，返回两个阶段各自的耗时，并校验弹出的顺序 */
+    template <typename HeapT>
+    std::vector<double> insertThenDrain(HeapT &heap, const std::vector<uint64_t> &keys) {
+        Utils::Stopwatch stopwatch;
+        for (uint64_t key : keys) {
+            heap.insert(key);
+        }
+        double insertMs = stopwatch.elapsedMilliseconds();
+
+        stopwatch.reset();
+        uint64_t previous = 0;
+        uint64_t checksum = 0;
+        while (!heap.empty()) {
+            uint64_t key = heap.top();
+            if (key < previous) {
+                std::cout << "out of order: " << key << " after " << previous << "\n";
+            }
+            previous = key;
+            checksum += key;
+            heap.pop();
+        }
+        double drainMs = stopwatch.elapsedMilliseconds();
+        sink = sink + checksum;
+        return { insertMs, drainMs };
+    }
+
+    /**
+     * 内存预算固定为 budgetBytes, 数据量是预算的 10 倍，对比 ExternalHeap 和完全放在内存里的 Heap.
+     * ExternalHeap 会写出大约 10 个顺串，弹出阶段在它们之间做 10 路归并。
+     * n 是元素个数（uint64），为 0 时默认 n = 20,000,000, 即 160 MB 的数据对 16 MB 的预算。
+     * 临时文件写在 std::filesystem::temp_directory_path() 下，测完即删除。
+     */
+    void run(size_t n) {
+        if (n == 0) {
+            n = 20'000'000;
+        }
+
+        auto keys = makeRandomIntegers<uint64_t>(n, 0, UINT64_MAX, 1);
+        ExternalHeapOptions options;
+        options.memoryBudgetBytes = n * sizeof(uint64_t) / 10;
+
+        std::vector<std::string> indexCol;
+        std::vector<std::string> headers { "insert", "drain", "insert + drain" };
+        std::vector<std::vector<std::string>> cells;
+        auto addRow = [&](const std::string &name, const std::vector<double> &ms) {
+            indexCol.push_back(name);
+            cells.push_back({
+                formatThroughput(n, ms[0]),
+                formatThroughput(n, ms[1]),
+                formatMilliseconds(ms[0] + ms[1])
+            });
+        };
+
+        Heap<uint64_t, std::greater<>> inMemory;
+        addRow("Heap (all in RAM)", insertThenDrain(inMemory, keys));
+
+        ExternalHeap<uint64_t, std::greater<>> external { options };
+        addRow("ExternalHeap", insertThenDrain(external, keys));
+
+        std::cout << n << " random uint64 keys, ExternalHeap budget " << (options.memoryBudgetBytes >> 20) << " MB"
+                  << " (read-ahead " << (options.readAheadBytes >> 10) << " KB per run) in "
+                  << options.tempDirectory.string() << "\n";
+        Utils::PrintTable(indexCol, headers, cells);
+    }
+
+}
+
+#endif //DATASTRUCTUREIMPLEMENTATIONS_EXTERNALHEAPBENCHMARK_HPP
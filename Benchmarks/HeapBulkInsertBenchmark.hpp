@@ -0,0 +1,82 @@
+#ifndef DATASTRUCTUREIMPLEMENTATIONS_HEAPBULKINSERTBENCHMARK_HPP
+#define DATASTRUCTUREIMPLEMENTATIONS_HEAPBULKINSERTBENCHMARK_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "BenchmarkUtils.hpp"
+#include "../DataStructures/Heap.hpp"
+#include "../Utils/Stopwatch.hpp"
+#include "../Utils/PrintTable.hpp"
+
+namespace Benchmark::HeapBulkInsert {
+
+    /** 在一个已有 base.size() 个元素的堆上批量插入 batch, 返回 pushBulk 的耗时 */
+    double timePushBulk(const std::vector<uint64_t> &base, const std::vector<uint64_t> &batch, BulkInsertStrategy strategy) {
+        // 预留好容量，避免把扩容时的整体复制也算进来
+        std::vector<uint64_t> storage;
+        storage.reserve(base.size() + batch.size());
+        storage.assign(base.begin(), base.end());
+        Heap<uint64_t> heap { std::move(storage) };
+        Utils::Stopwatch stopwatch;
+        heap.pushBulk(batch, strategy);
+        double ms = stopwatch.elapsedMilliseconds();
+        sink = sink + heap.top();
+        return ms;
+    }
+
+    /** 以 pool 的前若干个元素为批量，扫描不同的批量大小，打印一张对比表 */
+    void sweepBatchSizes(const std::string &title, const std::vector<uint64_t> &base, const std::vector<uint64_t> &pool) {
+        size_t n = base.size();
+        std::vector<std::string> indexCol;
+        std::vector<std::string> headers { "incremental", "rebuild", "auto" };
+        std::vector<std::vector<std::string>> cells;
+        for (size_t divisor : { 10000, 1000, 100, 30, 10, 5, 3, 2, 1 }) {
+            size_t batchSize = n / divisor;
+            std::vector<uint64_t> batch (pool.begin(), pool.begin() + static_cast<std::ptrdiff_t>(batchSize));
+            indexCol.push_back("batch = " + std::to_string(batchSize));
+            cells.push_back({
+                formatMilliseconds(timePushBulk(base, batch, BulkInsertStrategy::Incremental)),
+                formatMilliseconds(timePushBulk(base, batch, BulkInsertStrategy::Rebuild)),
+                formatMilliseconds(timePushBulk(base, batch, BulkInsertStrategy::Auto))
+            });
+        }
+
+        std::cout << title << "\n";
+        Utils::PrintTable(indexCol, headers, cells);
+    }
+
+    /**
+     * 扫描不同的批量大小，对比逐个上浮、整体重建和 Auto 策略的耗时，用来观察两者的交叉点。
+     * 随机的批量平均只上浮常数层，升序的批量则每个都要浮到接近根部，是逐个上浮的最坏情况。
+     * n 是已有堆的大小，为 0 时默认 n = 4,000,000.
+     */
+    void run(size_t n) {
+        if (n == 0) {
+            n = 4'000'000;
+        }
+
+        auto base = makeRandomIntegers<uint64_t>(n, 0, UINT32_MAX, 1);
+        auto pool = makeRandomIntegers<uint64_t>(n * 2, 0, UINT32_MAX, 2);
+        sweepBatchSizes("random batches into a heap of " + std::to_string(n) + " uint64 keys", base, pool);
+
+        std::vector<uint64_t> ascending (n * 2);
+        for (size_t i = 0; i < ascending.size(); ++i) {
+            ascending[i] = static_cast<uint64_t>(UINT32_MAX) + i;
+        }
+        sweepBatchSizes("ascending batches into a heap of " + std::to_string(n) + " uint64 keys", base, ascending);
+
+        Utils::Stopwatch stopwatch;
+        Heap<uint64_t> heap { std::vector<uint64_t>(pool) };
+        double buildMs = stopwatch.elapsedMilliseconds();
+        stopwatch.reset();
+        heap.updateComparator(std::less<> {});
+        double rebuildMs = stopwatch.elapsedMilliseconds();
+        sink = sink + heap.top();
+        std::cout << "bottom-up build of " << pool.size() << " keys: " << formatMilliseconds(buildMs)
+                  << ", rebuild on an existing heap: " << formatMilliseconds(rebuildMs) << "\n";
+    }
+
+}
+
+#endif //DATASTRUCTUREIMPLEMENTATIONS_HEAPBULKINSERTBENCHMARK_HPP
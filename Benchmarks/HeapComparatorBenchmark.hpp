@@ -0,0 +1,98 @@
+#ifndef DATASTRUCTUREIMPLEMENTATIONS_HEAPCOMPARATORBENCHMARK_HPP
+#define DATASTRUCTUREIMPLEMENTATIONS_HEAPCOMPARATORBENCHMARK_HPP
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+#include "BenchmarkUtils.hpp"
+#include "../DataStructures/Heap.hpp"
+#include "../Utils/Stopwatch.hpp"
+#include "../Utils/PrintTable.hpp"
+
+namespace Benchmark::HeapComparator {
+
+    /** 64 字节的负载，key 之外的部分模拟任务携带的数据 */
+    struct Payload64 {
+        uint64_t key;
+        std::array<uint64_t, 7> data;
+
+        bool operator<(const Payload64 &rhs) const {
+            return this->key < rhs.key;
+        }
+    };
+
+    /**
+     * 模拟事件循环：先预热到 n 个元素，然后交替做 n 次 pop + insert，
+     * 每一步都伴随着完整的一次下沉和一次上浮，比较操作的开销在这里占主导。
+     */
+    template <typename HeapT, typename T, typename MakeT>
+    double runEventLoop(HeapT &heap, const std::vector<uint64_t> &keys, const MakeT &make) {
+        size_t half = keys.size() / 2;
+        for (size_t i = 0; i < half; ++i) {
+            heap.insert(make(keys[i]));
+        }
+
+        Utils::Stopwatch stopwatch;
+        uint64_t checksum = 0;
+        for (size_t i = half; i < keys.size(); ++i) {
+            T item = heap.top();
+            heap.pop();
+            checksum += static_cast<uint64_t>(item < make(keys[i]));
+            heap.insert(make(keys[i]));
+        }
+        double ms = stopwatch.elapsedMilliseconds();
+        sink = sink + checksum;
+        return ms;
+    }
+
+    template <typename T, typename MakeT>
+    void addRows(
+        const std::string &typeName,
+        const std::vector<uint64_t> &keys,
+        const MakeT &make,
+        std::vector<std::string> &indexCol,
+        std::vector<std::vector<std::string>> &cells
+    ) {
+        size_t ops = keys.size() - keys.size() / 2;
+
+        Heap<T> inlinedHeap;
+        double inlinedMs = runEventLoop<Heap<T>, T>(inlinedHeap, keys, make);
+
+        RuntimeHeap<T> runtimeHeap { [](const T &a, const T &b) { return !(a < b); } };
+        double runtimeMs = runEventLoop<RuntimeHeap<T>, T>(runtimeHeap, keys, make);
+
+        indexCol.push_back(typeName);
+        cells.push_back({
+            formatMilliseconds(inlinedMs), formatThroughput(ops, inlinedMs),
+            formatMilliseconds(runtimeMs), formatThroughput(ops, runtimeMs)
+        });
+    }
+
+    /**
+     * 比较编译期比较器 Heap<T, std::less<>> 和运行时比较器 RuntimeHeap<T> 的开销，
+     * 负载分别是 int, double 和 64 字节的结构体。n 为 0 时默认 n = 4,000,000.
+     */
+    void run(size_t n) {
+        if (n == 0) {
+            n = 4'000'000;
+        }
+
+        auto keys = makeRandomIntegers<uint64_t>(n, 0, UINT32_MAX);
+
+        std::vector<std::string> indexCol;
+        std::vector<std::string> headers { "std::less<>", "rate", "std::function", "rate" };
+        std::vector<std::vector<std::string>> cells;
+
+        addRows<int>("int", keys, [](uint64_t key) { return static_cast<int>(key); }, indexCol, cells);
+        addRows<double>("double", keys, [](uint64_t key) { return static_cast<double>(key) * 0.5; }, indexCol, cells);
+        addRows<Payload64>("64-byte payload", keys, [](uint64_t key) { return Payload64 { key, {} }; }, indexCol, cells);
+
+        std::cout << "pop + insert pairs on a heap of " << n / 2 << " elements\n";
+        Utils::PrintTable(indexCol, headers, cells);
+    }
+
+}
+
+#endif //DATASTRUCTUREIMPLEMENTATIONS_HEAPCOMPARATORBENCHMARK_HPP
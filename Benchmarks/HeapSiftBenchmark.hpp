@@ -0,0 +1,146 @@
+#ifndef DATASTRUCTUREIMPLEMENTATIONS_HEAPSIFTBENCHMARK_HPP
+#define DATASTRUCTUREIMPLEMENTATIONS_HEAPSIFTBENCHMARK_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <queue>
+#include <string>
+#include <vector>
+#include "BenchmarkUtils.hpp"
+#include "../DataStructures/Heap.hpp"
+#include "../Utils/Stopwatch.hpp"
+#include "../Utils/PrintTable.hpp"
+
+namespace Benchmark::HeapSift {
+
+    /** 模拟调度队列里的任务，32 字节 */
+    struct Task {
+        uint64_t priority;
+        uint64_t id;
+        double weight;
+        uint32_t flags;
+    };
+
+    /** 先插入 keys 中的全部元素，再全部弹出，返回 {插入耗时, 弹出耗时} */
+    template <typename T, typename MakeT, typename PriorityOf>
+    std::pair<double, double> pushThenPopHeap(const std::vector<uint64_t> &keys, const MakeT &make, const PriorityOf &priorityOf) {
+        auto less = [&](const T &a, const T &b) { return priorityOf(a) < priorityOf(b); };
+        Heap<T, decltype(less)> heap { less };
+        Utils::Stopwatch stopwatch;
+        for (const auto &key : keys) {
+            heap.insert(make(key));
+        }
+        double pushMs = stopwatch.elapsedMilliseconds();
+
+        stopwatch.reset();
+        uint64_t checksum = 0;
+        while (!heap.empty()) {
+            checksum += priorityOf(heap.top());
+            heap.pop();
+        }
+        double popMs = stopwatch.elapsedMilliseconds();
+        sink = sink + checksum;
+        return { pushMs, popMs };
+    }
+
+    /** 同样的负载跑一遍 std::priority_queue, 作为参照 */
+    template <typename T, typename MakeT, typename PriorityOf>
+    std::pair<double, double> pushThenPopStd(const std::vector<uint64_t> &keys, const MakeT &make, const PriorityOf &priorityOf) {
+        auto less = [&](const T &a, const T &b) { return priorityOf(a) < priorityOf(b); };
+        std::priority_queue<T, std::vector<T>, decltype(less)> queue { less };
+        Utils::Stopwatch stopwatch;
+        for (const auto &key : keys) {
+            queue.push(make(key));
+        }
+        double pushMs = stopwatch.elapsedMilliseconds();
+
+        stopwatch.reset();
+        uint64_t checksum = 0;
+        while (!queue.empty()) {
+            checksum += priorityOf(queue.top());
+            queue.pop();
+        }
+        double popMs = stopwatch.elapsedMilliseconds();
+        sink = sink + checksum;
+        return { pushMs, popMs };
+    }
+
+    /**
+     * 核对 peekK 和 popK: 在若干个随机堆（key 的取值范围很小，有大量重复）上取不同的 k, 包括 0、大于堆大小的 k,
+     * peekK(k) 和 popK(k) 的结果都要等于排好序的副本的前 min(k, size) 个元素，popK 之后剩下的仍然是堆。
+     * 返回不一致的次数。
+     */
+    size_t checkPeekAndPopK() {
+        size_t failures = 0;
+        uint64_t seed = 1;
+        for (size_t size : { 0, 1, 2, 7, 64, 1000, 4097 }) {
+            for (size_t k : { size_t { 0 }, size_t { 1 }, size / 3, size / 2 + 1, size, size + 5 }) {
+                auto keys = makeRandomIntegers<int>(size, 0, 9, seed++);
+                std::vector<int> sorted = keys;
+                std::sort(sorted.begin(), sorted.end(), std::greater<>());
+                sorted.resize(std::min(k, size));
+
+                Heap<int> heap { std::move(keys) };
+                std::vector<int> peeked;
+                for (const int &key : heap.peekK(k)) {
+                    peeked.push_back(key);
+                }
+                std::vector<int> popped;
+                heap.popK(k, std::back_inserter(popped));
+
+                if (peeked != sorted || popped != sorted || heap.size() != size - sorted.size() || !heap.isHeapPropertySatisfied()) {
+                    ++failures;
+                }
+            }
+        }
+
+        return failures;
+    }
+
+    /**
+     * 对 Heap<T> 的 insert/pop 做吞吐测试：n 个随机 key 全部插入再全部弹出，
+     * 分别测 int 负载和 32 字节的 Task 负载，并以 std::priority_queue 作为参照。
+     * 开始之前先用 checkPeekAndPopK 核对一遍 peekK 和 popK.
+     * n 为 0 时使用默认的一千万。
+     */
+    void run(size_t n) {
+        if (n == 0) {
+            n = 10'000'000;
+        }
+
+        if (size_t failures = checkPeekAndPopK(); failures != 0) {
+            std::cout << "peekK / popK disagree with the sorted reference in " << failures << " cases\n";
+        }
+
+        auto keys = makeRandomIntegers<uint64_t>(n, 0, UINT32_MAX);
+        auto makeInt = [](uint64_t key) { return static_cast<int>(key); };
+        auto intPriority = [](int x) { return static_cast<uint64_t>(x); };
+        auto makeTask = [](uint64_t key) { return Task { key, key ^ 0x5bd1e995, static_cast<double>(key), 0 }; };
+        auto taskPriority = [](const Task &task) { return task.priority; };
+
+        std::vector<std::string> indexCol;
+        std::vector<std::string> headers { "push", "push rate", "pop", "pop rate" };
+        std::vector<std::vector<std::string>> cells;
+        auto addRow = [&](const std::string &name, std::pair<double, double> result) {
+            indexCol.push_back(name);
+            cells.push_back({
+                formatMilliseconds(result.first), formatThroughput(n, result.first),
+                formatMilliseconds(result.second), formatThroughput(n, result.second)
+            });
+        };
+
+        addRow("Heap<int>", pushThenPopHeap<int>(keys, makeInt, intPriority));
+        addRow("std::priority_queue<int>", pushThenPopStd<int>(keys, makeInt, intPriority));
+        addRow("Heap<Task>", pushThenPopHeap<Task>(keys, makeTask, taskPriority));
+        addRow("std::priority_queue<Task>", pushThenPopStd<Task>(keys, makeTask, taskPriority));
+
+        std::cout << "n = " << n << "\n";
+        Utils::PrintTable(indexCol, headers, cells);
+    }
+
+}
+
+#endif //DATASTRUCTUREIMPLEMENTATIONS_HEAPSIFTBENCHMARK_HPP
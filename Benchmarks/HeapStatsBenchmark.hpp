@@ -0,0 +1,117 @@
+#ifndef DATASTRUCTUREIMPLEMENTATIONS_HEAPSTATSBENCHMARK_HPP
+#define DATASTRUCTUREIMPLEMENTATIONS_HEAPSTATSBENCHMARK_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include "BenchmarkUtils.hpp"
+#include "../DataStructures/Heap.hpp"
+#include "../DataStructures/HeapStats.hpp"
+#include "../Utils/Stopwatch.hpp"
+#include "../Utils/PrintTable.hpp"
+
+namespace Benchmark::HeapInstrumentation {
+
+    /**
+     * 同一套负载：前一半 key 逐个 insert, 后一半 pushBulk, 然后 pop 掉 n / 4 个、popK 取出 n / 4 个，最后全部弹出。
+     * 返回弹出序列的校验和，并检查弹出的顺序是否从大到小。
+     */
+    template <typename HeapT>
+    uint64_t runWorkload(HeapT &heap, const std::vector<uint64_t> &keys, bool &ordered) {
+        const size_t n = keys.size();
+        for (size_t i = 0; i < n / 2; ++i) {
+            heap.insert(keys[i]);
+        }
+        heap.pushBulk(std::vector<uint64_t>(keys.begin() + static_cast<std::ptrdiff_t>(n / 2), keys.end()));
+
+        uint64_t checksum = 0;
+        uint64_t previous = UINT64_MAX;
+        auto record = [&](uint64_t key) {
+            ordered = ordered && key <= previous;
+            previous = key;
+            checksum = checksum * 31 + key;
+        };
+
+        for (size_t i = 0; i < n / 4; ++i) {
+            record(heap.topRef());
+            heap.pop();
+        }
+
+        std::vector<uint64_t> batch;
+        heap.popK(n / 4, std::back_inserter(batch));
+        std::for_each(batch.begin(), batch.end(), record);
+
+        while (!heap.empty()) {
+            record(heap.topRef());
+            heap.pop();
+        }
+
+        return checksum;
+    }
+
+    /**
+     * 统计策略的开销和输出：同一套负载（insert、pushBulk、pop、popK）分别跑在 NoHeapStats、CountingHeapStats
+     * 和 ValidatingHeapStats 的 Heap 上，弹出序列必须一致，最后打印 CountingHeapStats 的 dump().
+     * ValidatingHeapStats 每次修改之后都做一次 O(n) 的检查，只跑前 20,000 个 key, 它的计数必须和同样规模的
+     * CountingHeapStats 一致（检查本身的比较不计入统计）。Release 构建中 assert 被去掉，要看检查的开销得用 Debug 构建。
+     * n 为 0 时默认 n = 4,000,000.
+     */
+    void run(size_t n) {
+        if (n == 0) {
+            n = 4'000'000;
+        }
+
+        auto keys = makeRandomIntegers<uint64_t>(n, 0, UINT32_MAX);
+        bool ordered = true;
+
+        Utils::Stopwatch stopwatch;
+        Heap<uint64_t> plain;
+        uint64_t plainChecksum = runWorkload(plain, keys, ordered);
+        double plainMs = stopwatch.elapsedMilliseconds();
+
+        stopwatch.reset();
+        Heap<uint64_t, std::less<>, CountingHeapStats> counted;
+        uint64_t countedChecksum = runWorkload(counted, keys, ordered);
+        double countedMs = stopwatch.elapsedMilliseconds();
+
+        std::vector<uint64_t> smallKeys (keys.begin(), keys.begin() + static_cast<std::ptrdiff_t>(std::min<size_t>(n, 20'000)));
+        Heap<uint64_t, std::less<>, CountingHeapStats> smallCounted;
+        uint64_t smallCountedChecksum = runWorkload(smallCounted, smallKeys, ordered);
+
+        stopwatch.reset();
+        Heap<uint64_t, std::less<>, ValidatingHeapStats> validated;
+        uint64_t validatedChecksum = runWorkload(validated, smallKeys, ordered);
+        double validatedMs = stopwatch.elapsedMilliseconds();
+
+        if (!ordered || countedChecksum != plainChecksum || validatedChecksum != smallCountedChecksum) {
+            std::cout << "pop sequences disagree\n";
+        }
+        const CountingHeapStats &smallStats = smallCounted.stats();
+        const CountingHeapStats &validatedStats = validated.stats();
+        if (validatedStats.comparisons != smallStats.comparisons || validatedStats.moves != smallStats.moves
+            || validatedStats.maxSize != smallStats.maxSize || validatedStats.siftUpDepths != smallStats.siftUpDepths
+            || validatedStats.siftDownDepths != smallStats.siftDownDepths) {
+            std::cout << "ValidatingHeapStats counted differently from CountingHeapStats\n";
+        }
+        sink = sink + plainChecksum + validatedChecksum;
+
+        std::vector<std::string> indexCol { "NoHeapStats", "CountingHeapStats", "ValidatingHeapStats" };
+        std::vector<std::string> headers { "keys", "time" };
+        std::vector<std::vector<std::string>> cells {
+            { std::to_string(n), formatMilliseconds(plainMs) },
+            { std::to_string(n), formatMilliseconds(countedMs) },
+            { std::to_string(smallKeys.size()), formatMilliseconds(validatedMs) },
+        };
+
+        std::cout << "insert n / 2, pushBulk n / 2, pop n / 4, popK n / 4, drain\n";
+        Utils::PrintTable(indexCol, headers, cells);
+        std::cout << "\nCountingHeapStats, n = " << n << "\n";
+        counted.stats().dump();
+    }
+
+}
+
+#endif //DATASTRUCTUREIMPLEMENTATIONS_HEAPSTATSBENCHMARK_HPP
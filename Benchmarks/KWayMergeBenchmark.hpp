@@ -0,0 +1,129 @@
+#ifndef DATASTRUCTUREIMPLEMENTATIONS_KWAYMERGEBENCHMARK_HPP
+#define DATASTRUCTUREIMPLEMENTATIONS_KWAYMERGEBENCHMARK_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <utility>
+#include <vector>
+#include "BenchmarkUtils.hpp"
+#include "../Algorithms/KWayMerge.hpp"
+#include "../DataStructures/Heap.hpp"
+#include "../Utils/Stopwatch.hpp"
+#include "../Utils/PrintTable.hpp"
+
+namespace Benchmark::KWayMergeShards {
+
+    /** 把 n 个随机整数切成 k 个分片，每个分片各自排好序 */
+    std::vector<std::vector<uint32_t>> makeShards(size_t n, size_t k) {
+        auto keys = makeRandomIntegers<uint32_t>(n, 0, UINT32_MAX);
+        std::vector<std::vector<uint32_t>> shards (k);
+        for (size_t i = 0; i < n; ++i) {
+            shards[i % k].push_back(keys[i]);
+        }
+        for (auto &shard : shards) {
+            std::sort(shard.begin(), shard.end());
+        }
+
+        return shards;
+    }
+
+    /** 两两依次归并：把后一个分片归并进累积的结果，和 mergeKLists 原来的做法一样 */
+    std::vector<uint32_t> mergePairwise(const std::vector<std::vector<uint32_t>> &shards) {
+        std::vector<uint32_t> merged;
+        std::vector<uint32_t> buffer;
+        for (const auto &shard : shards) {
+            buffer.clear();
+            buffer.reserve(merged.size() + shard.size());
+            std::merge(merged.begin(), merged.end(), shard.begin(), shard.end(), std::back_inserter(buffer));
+            std::swap(merged, buffer);
+        }
+
+        return merged;
+    }
+
+    /** 二叉堆里放 k 个分片的头部，每次 replaceTop 一个新的头部 */
+    std::vector<uint32_t> mergeWithHeap(const std::vector<std::vector<uint32_t>> &shards) {
+        using Head = std::pair<uint32_t, uint32_t>;
+        Heap<Head, std::greater<>> heads;
+        std::vector<size_t> cursors (shards.size(), 0);
+        for (uint32_t s = 0; s < shards.size(); ++s) {
+            if (!shards[s].empty()) {
+                heads.insert(Head { shards[s][0], s });
+            }
+        }
+
+        std::vector<uint32_t> merged;
+        while (!heads.empty()) {
+            auto [key, s] = heads.topRef();
+            merged.push_back(key);
+            if (++cursors[s] < shards[s].size()) {
+                heads.replaceTop(Head { shards[s][cursors[s]], s });
+            } else {
+                heads.pop();
+            }
+        }
+
+        return merged;
+    }
+
+    std::vector<uint32_t> mergeWithLoserTree(const std::vector<std::vector<uint32_t>> &shards) {
+        std::vector<uint32_t> merged;
+        Algorithm::KWayMerge::mergeSortedRanges(shards, std::back_inserter(merged));
+        return merged;
+    }
+
+    template <typename Merge>
+    double measure(Merge merge, const std::vector<std::vector<uint32_t>> &shards, uint64_t &checksum) {
+        Utils::Stopwatch stopwatch;
+        auto merged = merge(shards);
+        double ms = stopwatch.elapsedMilliseconds();
+        checksum = 0;
+        for (uint32_t key : merged) {
+            checksum = checksum * 31 + key;
+        }
+        sink = sink + checksum;
+        return ms;
+    }
+
+    /**
+     * 归并 k 个有序分片，k 取 8, 64, 512, 对比两两归并、二叉堆、败者树三种做法。
+     * n 是元素总数，为 0 时默认 n = 8,000,000.
+     */
+    void run(size_t n) {
+        if (n == 0) {
+            n = 8'000'000;
+        }
+
+        std::vector<std::string> indexCol;
+        std::vector<std::string> headers { "pairwise", "Heap", "LoserTree" };
+        std::vector<std::vector<std::string>> cells;
+        for (size_t k : { size_t(8), size_t(64), size_t(512) }) {
+            auto shards = makeShards(n, k);
+            uint64_t pairwiseChecksum = 0;
+            uint64_t heapChecksum = 0;
+            uint64_t treeChecksum = 0;
+            double pairwiseMs = measure(mergePairwise, shards, pairwiseChecksum);
+            double heapMs = measure(mergeWithHeap, shards, heapChecksum);
+            double treeMs = measure(mergeWithLoserTree, shards, treeChecksum);
+            if (pairwiseChecksum != heapChecksum || pairwiseChecksum != treeChecksum) {
+                std::cout << "checksum mismatch with k = " << k << "\n";
+            }
+
+            indexCol.push_back("k = " + std::to_string(k));
+            cells.push_back({
+                formatThroughput(n, pairwiseMs),
+                formatThroughput(n, heapMs),
+                formatThroughput(n, treeMs)
+            });
+        }
+
+        std::cout << "merging " << n << " keys from k sorted shards\n";
+        Utils::PrintTable(indexCol, headers, cells);
+    }
+
+}
+
+#endif //DATASTRUCTUREIMPLEMENTATIONS_KWAYMERGEBENCHMARK_HPP
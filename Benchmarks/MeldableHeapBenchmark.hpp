@@ -0,0 +1,147 @@
+#ifndef DATASTRUCTUREIMPLEMENTATIONS_MELDABLEHEAPBENCHMARK_HPP
+#define DATASTRUCTUREIMPLEMENTATIONS_MELDABLEHEAPBENCHMARK_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include "BenchmarkUtils.hpp"
+#include "../DataStructures/Heap.hpp"
+#include "../DataStructures/AddressableHeap.hpp"
+#include "../DataStructures/PairingHeap.hpp"
+#include "../DataStructures/FibonacciHeap.hpp"
+#include "../Utils/Stopwatch.hpp"
+#include "../Utils/PrintTable.hpp"
+
+namespace Benchmark::MeldableHeap {
+
+    /** 依次弹出全部元素，返回弹出序列的校验和，并检查弹出的顺序是否从大到小 */
+    template <typename HeapT>
+    uint64_t drain(HeapT &heap, bool &ordered) {
+        uint64_t checksum = 0;
+        uint32_t previous = UINT32_MAX;
+        while (!heap.empty()) {
+            uint32_t key = heap.top();
+            ordered = ordered && key <= previous;
+            previous = key;
+            checksum = checksum * 31 + key;
+            heap.pop();
+        }
+
+        return checksum;
+    }
+
+    /**
+     * 分片合并：shards 个分片各自建好堆，然后合并成一个堆再全部弹出。
+     * Heap 没有 meld, 只能把其他分片的元素逐个插进来；PairingHeap / FibonacciHeap 逐个 meld, 每次 O(1).
+     * 返回 {合并耗时, 弹出耗时, 校验和}
+     */
+    template <typename HeapT>
+    std::tuple<double, double, uint64_t> mergeShards(const std::vector<std::vector<uint32_t>> &shardKeys, bool &ordered) {
+        std::vector<HeapT> shards (shardKeys.size());
+        for (size_t s = 0; s < shardKeys.size(); ++s) {
+            for (uint32_t key : shardKeys[s]) {
+                shards[s].insert(key);
+            }
+        }
+
+        Utils::Stopwatch stopwatch;
+        HeapT merged = std::move(shards[0]);
+        for (size_t s = 1; s < shards.size(); ++s) {
+            if constexpr (requires { merged.meld(std::move(shards[s])); }) {
+                merged.meld(std::move(shards[s]));
+            } else {
+                merged.pushBulk(shardKeys[s]);
+            }
+        }
+        double mergeMs = stopwatch.elapsedMilliseconds();
+
+        stopwatch.reset();
+        uint64_t checksum = drain(merged, ordered);
+        return { mergeMs, stopwatch.elapsedMilliseconds(), checksum };
+    }
+
+    /**
+     * 插入 keys 中的全部元素，再对随机挑选的 updates 个元素做 increaseKey（优先级只升不降），最后全部弹出。
+     * 返回 {increaseKey 耗时, 弹出耗时, 校验和}
+     */
+    template <typename HeapT>
+    std::tuple<double, double, uint64_t> increaseKeys(const std::vector<uint32_t> &keys, const std::vector<std::pair<uint32_t, uint32_t>> &updates, bool &ordered) {
+        HeapT heap;
+        std::vector<typename HeapT::Handle> handles;
+        std::vector<uint32_t> current = keys;
+        handles.reserve(keys.size());
+        for (uint32_t key : keys) {
+            handles.push_back(heap.insert(key));
+        }
+
+        Utils::Stopwatch stopwatch;
+        for (const auto &[idx, delta] : updates) {
+            current[idx] += std::min(delta, UINT32_MAX - current[idx]);
+            heap.increaseKey(handles[idx], current[idx]);
+        }
+        double updateMs = stopwatch.elapsedMilliseconds();
+
+        stopwatch.reset();
+        uint64_t checksum = drain(heap, ordered);
+        return { updateMs, stopwatch.elapsedMilliseconds(), checksum };
+    }
+
+    /**
+     * 对比 PairingHeap、FibonacciHeap 和数组堆：
+     * - 64 个分片的合并（Heap 逐个插入，另外两个 meld）以及合并之后的弹出；
+     * - n / 2 次随机的 increaseKey（对照是 AddressableHeap）以及之后的弹出。
+     * 每一种实现的弹出序列都要从大到小、并且校验和一致。n 为 0 时默认 n = 2,000,000.
+     */
+    void run(size_t n) {
+        if (n == 0) {
+            n = 2'000'000;
+        }
+
+        const size_t shardCount = 64;
+        auto keys = makeRandomIntegers<uint32_t>(n, 0, UINT32_MAX / 2);
+        std::vector<std::vector<uint32_t>> shardKeys (shardCount);
+        for (size_t i = 0; i < n; ++i) {
+            shardKeys[i % shardCount].push_back(keys[i]);
+        }
+
+        std::mt19937_64 engine { 20221017 };
+        std::uniform_int_distribution<uint32_t> idxDistribution { 0, static_cast<uint32_t>(n - 1) };
+        std::uniform_int_distribution<uint32_t> deltaDistribution { 0, UINT32_MAX / 4 };
+        std::vector<std::pair<uint32_t, uint32_t>> updates;
+        for (size_t i = 0; i < n / 2; ++i) {
+            updates.emplace_back(idxDistribution(engine), deltaDistribution(engine));
+        }
+
+        bool ordered = true;
+        auto [heapMergeMs, heapDrainMs, heapChecksum] = mergeShards<Heap<uint32_t>>(shardKeys, ordered);
+        auto [pairingMergeMs, pairingDrainMs, pairingChecksum] = mergeShards<PairingHeap<uint32_t>>(shardKeys, ordered);
+        auto [fibonacciMergeMs, fibonacciDrainMs, fibonacciChecksum] = mergeShards<FibonacciHeap<uint32_t>>(shardKeys, ordered);
+        auto [addressableUpdateMs, addressableDrainMs, addressableChecksum] = increaseKeys<AddressableHeap<uint32_t>>(keys, updates, ordered);
+        auto [pairingUpdateMs, pairingUpdateDrainMs, pairingUpdateChecksum] = increaseKeys<PairingHeap<uint32_t>>(keys, updates, ordered);
+        auto [fibonacciUpdateMs, fibonacciUpdateDrainMs, fibonacciUpdateChecksum] = increaseKeys<FibonacciHeap<uint32_t>>(keys, updates, ordered);
+        if (!ordered || pairingChecksum != heapChecksum || fibonacciChecksum != heapChecksum
+            || pairingUpdateChecksum != addressableChecksum || fibonacciUpdateChecksum != addressableChecksum) {
+            std::cout << "pop sequences disagree\n";
+        }
+        sink = sink + heapChecksum + addressableChecksum;
+
+        std::vector<std::string> indexCol { "Heap / AddressableHeap", "PairingHeap", "FibonacciHeap" };
+        std::vector<std::string> headers { "merge 64 shards", "drain", "increaseKey x n/2", "drain" };
+        std::vector<std::vector<std::string>> cells {
+            { formatMilliseconds(heapMergeMs), formatMilliseconds(heapDrainMs), formatMilliseconds(addressableUpdateMs), formatMilliseconds(addressableDrainMs) },
+            { formatMilliseconds(pairingMergeMs), formatMilliseconds(pairingDrainMs), formatMilliseconds(pairingUpdateMs), formatMilliseconds(pairingUpdateDrainMs) },
+            { formatMilliseconds(fibonacciMergeMs), formatMilliseconds(fibonacciDrainMs), formatMilliseconds(fibonacciUpdateMs), formatMilliseconds(fibonacciUpdateDrainMs) },
+        };
+
+        std::cout << "n = " << n << "\n";
+        Utils::PrintTable(indexCol, headers, cells);
+    }
+
+}
+
+#endif //DATASTRUCTUREIMPLEMENTATIONS_MELDABLEHEAPBENCHMARK_HPP
@@ -0,0 +1,118 @@
+#ifndef DATASTRUCTUREIMPLEMENTATIONS_MINMAXHEAPBENCHMARK_HPP
+#define DATASTRUCTUREIMPLEMENTATIONS_MINMAXHEAPBENCHMARK_HPP
+
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+#include "BenchmarkUtils.hpp"
+#include "../DataStructures/Heap.hpp"
+#include "../DataStructures/MinMaxHeap.hpp"
+#include "../Utils/Stopwatch.hpp"
+#include "../Utils/PrintTable.hpp"
+
+namespace Benchmark::BestNTracker {
+
+    /** 分数和到达的序号，序号让所有的元素两两不同，两种实现淘汰和取出的顺序才能逐个核对 */
+    using Entry = std::pair<uint32_t, uint32_t>;
+
+    constexpr size_t capacity = 10'000;
+
+    /** 每到达 serveEvery 个元素，取出一次当前最好的那个 */
+    constexpr size_t serveEvery = 4;
+
+    /** 取出的元素序列的校验和 */
+    uint64_t accumulate(uint64_t checksum, const Entry &entry) {
+        return checksum * 31 + entry.first * 7 + entry.second;
+    }
+
+    /** 一个 MinMaxHeap: 超过容量就 popMin() 淘汰最差的，popMax() 取出最好的 */
+    uint64_t trackWithMinMaxHeap(const std::vector<uint32_t> &scores) {
+        MinMaxHeap<Entry> heap;
+        uint64_t checksum = 0;
+        for (uint32_t i = 0; i < scores.size(); ++i) {
+            heap.insert(Entry { scores[i], i });
+            if (heap.size() > capacity) {
+                heap.popMin();
+            }
+            if (i % serveEvery == serveEvery - 1) {
+                checksum = accumulate(checksum, heap.max());
+                heap.popMax();
+            }
+        }
+
+        return checksum;
+    }
+
+    /** 原来的做法：一个小顶堆、一个大顶堆各存一份，另一边删掉的元素记在 alive 里，弹到堆顶时再跳过 */
+    uint64_t trackWithTwoHeaps(const std::vector<uint32_t> &scores) {
+        Heap<Entry, std::greater<>> worst;
+        Heap<Entry> best;
+        std::vector<bool> alive (scores.size(), false);
+        size_t liveCount = 0;
+        auto popLive = [&](auto &heap) {
+            while (!alive[heap.topRef().second]) {
+                heap.pop();
+            }
+            Entry entry = heap.topRef();
+            heap.pop();
+            alive[entry.second] = false;
+            --liveCount;
+            return entry;
+        };
+
+        uint64_t checksum = 0;
+        for (uint32_t i = 0; i < scores.size(); ++i) {
+            worst.insert(Entry { scores[i], i });
+            best.insert(Entry { scores[i], i });
+            alive[i] = true;
+            if (++liveCount > capacity) {
+                popLive(worst);
+            }
+            if (i % serveEvery == serveEvery - 1) {
+                checksum = accumulate(checksum, popLive(best));
+            }
+        }
+
+        return checksum;
+    }
+
+    /**
+     * 有界的 "best N" 集合（N = 10,000）：每到达一个元素就插入，超过 N 个时淘汰最差的，每 4 个元素取出一次最好的。
+     * 对比一个 MinMaxHeap 和"两个 Heap + 延迟删除"两种做法，两者取出的序列必须一致。
+     * n 是到达的元素个数，为 0 时默认 n = 10,000,000.
+     */
+    void run(size_t n) {
+        if (n == 0) {
+            n = 10'000'000;
+        }
+
+        auto scores = makeRandomIntegers<uint32_t>(n, 0, UINT32_MAX);
+        Utils::Stopwatch stopwatch;
+        uint64_t minMaxChecksum = trackWithMinMaxHeap(scores);
+        double minMaxMs = stopwatch.elapsedMilliseconds();
+
+        stopwatch.reset();
+        uint64_t twoHeapsChecksum = trackWithTwoHeaps(scores);
+        double twoHeapsMs = stopwatch.elapsedMilliseconds();
+        if (minMaxChecksum != twoHeapsChecksum) {
+            std::cout << "served sequences disagree\n";
+        }
+        sink = sink + minMaxChecksum;
+
+        std::vector<std::string> indexCol { "MinMaxHeap", "two Heaps + lazy deletion" };
+        std::vector<std::string> headers { "time", "throughput" };
+        std::vector<std::vector<std::string>> cells {
+            { formatMilliseconds(minMaxMs), formatThroughput(n, minMaxMs) },
+            { formatMilliseconds(twoHeapsMs), formatThroughput(n, twoHeapsMs) },
+        };
+
+        std::cout << n << " arrivals, best " << capacity << " kept, best one served every " << serveEvery << " arrivals\n";
+        Utils::PrintTable(indexCol, headers, cells);
+    }
+
+}
+
+#endif //DATASTRUCTUREIMPLEMENTATIONS_MINMAXHEAPBENCHMARK_HPP
@@ -0,0 +1,117 @@
+#ifndef DATASTRUCTUREIMPLEMENTATIONS_MULTIQUEUEBENCHMARK_HPP
+#define DATASTRUCTUREIMPLEMENTATIONS_MULTIQUEUEBENCHMARK_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "BenchmarkUtils.hpp"
+#include "../DataStructures/Heap.hpp"
+#include "../DataStructures/MultiQueue.hpp"
+#include "../Utils/Stopwatch.hpp"
+#include "../Utils/PrintTable.hpp"
+
+namespace Benchmark::MultiQueueScaling {
+
+    /** 作为对照：所有线程共用一把锁和一个 Heap, 也就是目前调度器的做法 */
+    class SingleLockQueue {
+    public:
+        explicit SingleLockQueue(size_t) { }
+
+        void insert(uint64_t key) {
+            std::lock_guard<std::mutex> guard (this->lock);
+            this->heap.insert(key);
+        }
+
+        bool tryPop(uint64_t &out) {
+            std::lock_guard<std::mutex> guard (this->lock);
+            if (this->heap.empty()) {
+                return false;
+            }
+            out = this->heap.top();
+            this->heap.pop();
+            return true;
+        }
+
+    private:
+        std::mutex lock;
+        Heap<uint64_t> heap;
+    };
+
+    /** 以 threadCount 个线程各自交替执行 insert 和 tryPop, 返回总耗时 */
+    template <typename QueueT>
+    double runThreads(QueueT &queue, size_t threadCount, size_t totalOps, size_t prefill) {
+        for (uint64_t i = 0; i < prefill; ++i) {
+            queue.insert(i * 2654435761u % (prefill * 4));
+        }
+
+        std::atomic<bool> go { false };
+        std::vector<std::thread> workers;
+        size_t opsPerThread = totalOps / threadCount;
+        for (size_t t = 0; t < threadCount; ++t) {
+            workers.emplace_back([&queue, &go, opsPerThread, t] {
+                while (!go.load(std::memory_order_acquire)) {
+                    std::this_thread::yield();
+                }
+
+                uint64_t key = t * 0x9e3779b97f4a7c15ull;
+                uint64_t checksum = 0;
+                for (size_t i = 0; i < opsPerThread; i += 2) {
+                    key = key * 6364136223846793005ull + 1442695040888963407ull;
+                    queue.insert(key >> 40);
+                    uint64_t popped = 0;
+                    if (queue.tryPop(popped)) {
+                        checksum += popped;
+                    }
+                }
+                sink = sink + checksum;
+            });
+        }
+
+        Utils::Stopwatch stopwatch;
+        go.store(true, std::memory_order_release);
+        for (auto &worker : workers) {
+            worker.join();
+        }
+        return stopwatch.elapsedMilliseconds();
+    }
+
+    /**
+     * 1 到 64 个线程下 MultiQueue 与"一把锁 + 一个 Heap"的吞吐对比，
+     * 每个线程交替 insert 和 tryPop, 队列预先装入 100 万个元素。
+     * n 是所有线程的总操作次数，为 0 时默认 n = 8,000,000.
+     */
+    void run(size_t n) {
+        if (n == 0) {
+            n = 8'000'000;
+        }
+
+        const size_t prefill = 1'000'000;
+        std::vector<std::string> indexCol;
+        std::vector<std::string> headers { "single lock", "rate", "MultiQueue c=2", "rate", "MultiQueue c=4", "rate" };
+        std::vector<std::vector<std::string>> cells;
+        for (size_t threadCount : { 1, 2, 4, 8, 16, 32, 64 }) {
+            SingleLockQueue single { threadCount };
+            double singleMs = runThreads(single, threadCount, n, prefill);
+            MultiQueue<uint64_t> relaxed2 { threadCount, 2 };
+            double relaxed2Ms = runThreads(relaxed2, threadCount, n, prefill);
+            MultiQueue<uint64_t> relaxed4 { threadCount, 4 };
+            double relaxed4Ms = runThreads(relaxed4, threadCount, n, prefill);
+
+            indexCol.push_back(std::to_string(threadCount) + " threads");
+            cells.push_back({
+                formatMilliseconds(singleMs), formatThroughput(n, singleMs),
+                formatMilliseconds(relaxed2Ms), formatThroughput(n, relaxed2Ms),
+                formatMilliseconds(relaxed4Ms), formatThroughput(n, relaxed4Ms)
+            });
+        }
+
+        std::cout << n << " operations in total, hardware threads: " << std::thread::hardware_concurrency() << "\n";
+        Utils::PrintTable(indexCol, headers, cells);
+    }
+
+}
+
+#endif //DATASTRUCTUREIMPLEMENTATIONS_MULTIQUEUEBENCHMARK_HPP
@@ -0,0 +1,103 @@
+#ifndef DATASTRUCTUREIMPLEMENTATIONS_PERSISTENTHEAPBENCHMARK_HPP
+#define DATASTRUCTUREIMPLEMENTATIONS_PERSISTENTHEAPBENCHMARK_HPP
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "BenchmarkUtils.hpp"
+#include "../DataStructures/Heap.hpp"
+#include "../DataStructures/PersistentHeap.hpp"
+#include "../Utils/Stopwatch.hpp"
+#include "../Utils/PrintTable.hpp"
+
+namespace Benchmark::SpeculativeSchedule {
+
+    /** 试探的次数 */
+    constexpr size_t trials = 200;
+
+    /** 每次试探弹出、插入的任务个数 */
+    constexpr size_t stepsPerTrial = 100;
+
+    /** 第 trial 次试探中第 step 步新来的任务的优先级 */
+    uint32_t arrival(size_t trial, size_t step) {
+        return static_cast<uint32_t>((trial * 2654435761u + step * 40503u) & 0x7fffffffu);
+    }
+
+    /** 原来的做法：每次试探都把整个堆复制一份（Heap 不能复制，只能从保存的数组重新建堆），试完丢掉 */
+    uint64_t speculateWithCopies(const std::vector<uint32_t> &base) {
+        uint64_t checksum = 0;
+        for (size_t trial = 0; trial < trials; ++trial) {
+            Heap<uint32_t> attempt { std::vector<uint32_t>(base) };
+            for (size_t step = 0; step < stepsPerTrial; ++step) {
+                checksum = checksum * 31 + attempt.topRef();
+                attempt.pop();
+                attempt.insert(arrival(trial, step));
+            }
+        }
+
+        return checksum;
+    }
+
+    /** 每次试探从同一个版本出发，试完丢掉新版本就回滚了；结束时检查节点都已经还给了 Arena */
+    uint64_t speculateWithVersions(const std::vector<uint32_t> &base, bool &leaked) {
+        PersistentHeap<uint32_t>::Arena arena;
+        PersistentHeap<uint32_t> committed { arena };
+        for (uint32_t key : base) {
+            committed = committed.insert(key);
+        }
+
+        uint64_t checksum = 0;
+        for (size_t trial = 0; trial < trials; ++trial) {
+            PersistentHeap<uint32_t> attempt = committed;
+            for (size_t step = 0; step < stepsPerTrial; ++step) {
+                checksum = checksum * 31 + attempt.top();
+                attempt = attempt.pop().insert(arrival(trial, step));
+            }
+        }
+        leaked = arena.nodeCount() != committed.size();
+
+        return checksum;
+    }
+
+    /**
+     * 试探性调度：已提交的队列里有 n 个任务，做 200 次试探，每次从已提交的队列出发弹出 100 个、插入 100 个，然后回滚。
+     * 对比每次复制 Heap 和 PersistentHeap 打快照两种做法，两者的弹出序列必须一致。
+     * n 为 0 时默认 n = 1,000,000.
+     */
+    void run(size_t n) {
+        if (n == 0) {
+            n = 1'000'000;
+        }
+
+        auto base = makeRandomIntegers<uint32_t>(n, 0, INT32_MAX);
+        Utils::Stopwatch stopwatch;
+        uint64_t copyChecksum = speculateWithCopies(base);
+        double copyMs = stopwatch.elapsedMilliseconds();
+
+        bool leaked = false;
+        stopwatch.reset();
+        uint64_t versionChecksum = speculateWithVersions(base, leaked);
+        double versionMs = stopwatch.elapsedMilliseconds();
+        if (copyChecksum != versionChecksum) {
+            std::cout << "pop sequences disagree\n";
+        }
+        if (leaked) {
+            std::cout << "rolled-back versions left nodes in the arena\n";
+        }
+        sink = sink + versionChecksum;
+
+        std::vector<std::string> indexCol { "copy Heap per trial", "PersistentHeap snapshots (incl. build)" };
+        std::vector<std::string> headers { "total", "per trial" };
+        std::vector<std::vector<std::string>> cells {
+            { formatMilliseconds(copyMs), formatMilliseconds(copyMs / trials) },
+            { formatMilliseconds(versionMs), formatMilliseconds(versionMs / trials) },
+        };
+
+        std::cout << n << " committed tasks, " << trials << " trials of " << stepsPerTrial << " pops + inserts each\n";
+        Utils::PrintTable(indexCol, headers, cells);
+    }
+
+}
+
+#endif //DATASTRUCTUREIMPLEMENTATIONS_PERSISTENTHEAPBENCHMARK_HPP
@@ -0,0 +1,161 @@
+#ifndef DATASTRUCTUREIMPLEMENTATIONS_POINTTOPOINTBENCHMARK_HPP
+#define DATASTRUCTUREIMPLEMENTATIONS_POINTTOPOINTBENCHMARK_HPP
+
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "BenchmarkUtils.hpp"
+#include "../Algorithms/Dijkstra.hpp"
+#include "../Utils/Stopwatch.hpp"
+#include "../Utils/PrintTable.hpp"
+
+namespace Benchmark::PointToPoint {
+
+    using namespace Algorithm::DijkstraShortestPathDistanceAlgorithm;
+
+    using Graph = CompressedGraph<uint32_t, float>;
+
+    /**
+     * side x side 的网格，相邻格子的间距是 1, 每条边的权值是间距乘以 [1, 1.5] 中的随机系数，
+     * 所以到目标的直线距离是一个一致的（也就是可采纳的）heuristic, 类似带坐标的路网。
+     */
+    Graph makeGeometricGrid(size_t side, uint64_t seed = 20221017) {
+        std::mt19937_64 engine { seed };
+        std::uniform_real_distribution<float> factorDistribution { 1.0f, 1.5f };
+        Graph graph;
+        graph.offsets.reserve(side * side + 1);
+        graph.offsets.push_back(0);
+        for (size_t row = 0; row < side; ++row) {
+            for (size_t col = 0; col < side; ++col) {
+                auto connect = [&](size_t r, size_t c) {
+                    graph.targets.push_back(static_cast<uint32_t>(r * side + c));
+                    graph.weights.push_back(factorDistribution(engine));
+                };
+                if (row > 0) {
+                    connect(row - 1, col);
+                }
+                if (col > 0) {
+                    connect(row, col - 1);
+                }
+                if (col + 1 < side) {
+                    connect(row, col + 1);
+                }
+                if (row + 1 < side) {
+                    connect(row + 1, col);
+                }
+                graph.offsets.push_back(graph.targets.size());
+            }
+        }
+
+        return graph;
+    }
+
+    /** 包装一个队列策略，数一数出队的次数（大致就是展开的节点个数） */
+    template <typename QueuePolicy>
+    class CountingQueuePolicy {
+    public:
+        explicit CountingQueuePolicy(size_t *pops) : queue(), pops(pops) { }
+
+        void push(NodeId nodeId, Distance d) {
+            this->queue.push(nodeId, d);
+        }
+
+        void pop() {
+            this->queue.pop();
+            ++*this->pops;
+        }
+
+        [[nodiscard]] bool empty() const {
+            return this->queue.empty();
+        }
+
+        [[nodiscard]] NodeId topNode() const {
+            return this->queue.topNode();
+        }
+
+        [[nodiscard]] Distance topDistance() const {
+            return this->queue.topDistance();
+        }
+
+    private:
+        QueuePolicy queue;
+        size_t *pops;
+    };
+
+    /**
+     * 在 side x side 的带坐标网格上做随机的起点、终点之间的查询，
+     * 对比单向 Dijkstra（目标出队即停止）、双向 Dijkstra 和以直线距离为 heuristic 的 A*,
+     * 列出平均每次查询的耗时和出队次数。n 是节点个数，为 0 时默认 n = 1,000,000.
+     */
+    void run(size_t n) {
+        if (n == 0) {
+            n = 1'000'000;
+        }
+
+        const size_t side = static_cast<size_t>(std::sqrt(static_cast<double>(n)));
+        const Graph graph = makeGeometricGrid(side);
+        const Graph reversed = graph.reversed();
+        const size_t queries = 50;
+
+        std::mt19937_64 engine { 20221017 };
+        std::uniform_int_distribution<NodeId> vertexDistribution { 0, graph.vertexCount() - 1 };
+        std::vector<std::pair<NodeId, NodeId>> pairs;
+        for (size_t i = 0; i < queries; ++i) {
+            pairs.emplace_back(vertexDistribution(engine), vertexDistribution(engine));
+        }
+
+        using Queue = CountingQueuePolicy<HeapQueuePolicy>;
+        double dijkstraMs = 0, bidirectionalMs = 0, aStarMs = 0;
+        size_t dijkstraPops = 0, bidirectionalPops = 0, aStarPops = 0;
+        size_t mismatches = 0;
+        std::vector<Distance> minDist;
+        for (const auto &[start, target] : pairs) {
+            auto euclidean = [&, target = target](NodeId v) {
+                double dr = static_cast<double>(v / side) - static_cast<double>(target / side);
+                double dc = static_cast<double>(v % side) - static_cast<double>(target % side);
+                return std::sqrt(dr * dr + dc * dc);
+            };
+
+            Utils::Stopwatch stopwatch;
+            Distance expected = calculateMinDistance(graph, start, target, minDist, Queue(&dijkstraPops));
+            dijkstraMs += stopwatch.elapsedMilliseconds();
+
+            stopwatch.reset();
+            Distance bidirectional = calculateMinDistanceBidirectional(graph, reversed, start, target, Queue(&bidirectionalPops), Queue(&bidirectionalPops));
+            bidirectionalMs += stopwatch.elapsedMilliseconds();
+
+            stopwatch.reset();
+            Distance aStar = calculateMinDistanceAStar(graph, start, target, euclidean, Queue(&aStarPops));
+            aStarMs += stopwatch.elapsedMilliseconds();
+
+            // 三种搜索的加法顺序不同，允许一点点浮点误差
+            if (std::abs(bidirectional - expected) > 1e-6 * expected || std::abs(aStar - expected) > 1e-6 * expected) {
+                ++mismatches;
+            }
+            sink = sink + static_cast<uint64_t>(expected);
+        }
+        if (mismatches > 0) {
+            std::cout << mismatches << " queries disagree\n";
+        }
+
+        auto perQuery = [queries](size_t pops) {
+            return std::to_string(pops / queries);
+        };
+        std::vector<std::string> indexCol { "Dijkstra, early exit", "bidirectional Dijkstra", "A*, straight-line" };
+        std::vector<std::string> headers { "time / query", "pops / query" };
+        std::vector<std::vector<std::string>> cells {
+            { formatMilliseconds(dijkstraMs / queries), perQuery(dijkstraPops) },
+            { formatMilliseconds(bidirectionalMs / queries), perQuery(bidirectionalPops) },
+            { formatMilliseconds(aStarMs / queries), perQuery(aStarPops) },
+        };
+
+        std::cout << queries << " random point-to-point queries on a " << side << " x " << side << " geometric grid\n";
+        Utils::PrintTable(indexCol, headers, cells);
+    }
+
+}
+
+#endif //DATASTRUCTUREIMPLEMENTATIONS_POINTTOPOINTBENCHMARK_HPP
@@ -0,0 +1,131 @@
+#ifndef DATASTRUCTUREIMPLEMENTATIONS_STABLEHEAPBENCHMARK_HPP
+#define DATASTRUCTUREIMPLEMENTATIONS_STABLEHEAPBENCHMARK_HPP
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "BenchmarkUtils.hpp"
+#include "../DataStructures/Heap.hpp"
+#include "../DataStructures/StableHeap.hpp"
+#include "../Utils/Stopwatch.hpp"
+#include "../Utils/PrintTable.hpp"
+
+namespace Benchmark::FairShareDispatch {
+
+    /** 优先级的取值范围是 [0, priorityLevels) */
+    constexpr uint32_t priorityLevels = 8;
+
+    struct Task {
+        uint32_t priority;
+        uint32_t id;
+    };
+
+    /** 只比较优先级，id 是到达的顺序 */
+    struct ByPriority {
+        bool operator()(const Task &lhs, const Task &rhs) const {
+            return lhs.priority < rhs.priority;
+        }
+    };
+
+    /** 一次分发的结果：弹出序列的校验和，以及同一优先级里后到的任务先出队的次数 */
+    struct DispatchResult {
+        uint64_t checksum = 0;
+        size_t fifoViolations = 0;
+        std::vector<uint32_t> lastId = std::vector<uint32_t>(priorityLevels, 0);
+        std::vector<bool> seen = std::vector<bool>(priorityLevels, false);
+
+        void record(const Task &task) {
+            this->checksum = this->checksum * 31 + task.id;
+            if (this->seen[task.priority] && task.id < this->lastId[task.priority]) {
+                ++this->fifoViolations;
+            }
+            this->seen[task.priority] = true;
+            this->lastId[task.priority] = task.id;
+        }
+    };
+
+    /**
+     * 先让一半的任务到达，之后每到达一个任务就分发一个，最后把剩下的全部分发出去。
+     * insert(task) 让任务入队，popTask() 弹出并返回下一个要分发的任务。
+     */
+    template <typename Insert, typename PopTask>
+    DispatchResult dispatch(const std::vector<uint32_t> &priorities, Insert insert, PopTask popTask) {
+        DispatchResult result;
+        const size_t n = priorities.size();
+        for (uint32_t id = 0; id < n; ++id) {
+            insert(Task { priorities[id], id });
+            if (id >= n / 2) {
+                result.record(popTask());
+            }
+        }
+        for (size_t i = n - n / 2; i < n; ++i) {
+            result.record(popTask());
+        }
+
+        return result;
+    }
+
+    /**
+     * 公平分发：n 个任务，优先级只有 8 档，优先级高的先分发，同一优先级必须先到先得。
+     * 对比 StableHeap、PackedStableHeap（优先级和序号打包成一个 uint64_t）和不稳定的 Heap,
+     * 两种稳定堆的分发序列必须一致并且没有违反先到先得的情况。n 为 0 时默认 n = 10,000,000.
+     */
+    void run(size_t n) {
+        if (n == 0) {
+            n = 10'000'000;
+        }
+
+        auto priorities = makeRandomIntegers<uint32_t>(n, 0, priorityLevels - 1);
+
+        Utils::Stopwatch stopwatch;
+        StableHeap<Task, ByPriority> stable;
+        DispatchResult stableResult = dispatch(
+            priorities,
+            [&](const Task &task) { stable.insert(task); },
+            [&]() { return stable.extract(); }
+        );
+        double stableMs = stopwatch.elapsedMilliseconds();
+
+        stopwatch.reset();
+        PackedStableHeap<uint32_t> packed;
+        DispatchResult packedResult = dispatch(
+            priorities,
+            [&](const Task &task) { packed.insert(task.priority, task.id); },
+            [&]() {
+                Task task { static_cast<uint32_t>(packed.topPriority()), packed.topValue() };
+                packed.pop();
+                return task;
+            }
+        );
+        double packedMs = stopwatch.elapsedMilliseconds();
+
+        stopwatch.reset();
+        Heap<Task, ByPriority> unstable;
+        DispatchResult unstableResult = dispatch(
+            priorities,
+            [&](const Task &task) { unstable.insert(task); },
+            [&]() { return unstable.extract(); }
+        );
+        double unstableMs = stopwatch.elapsedMilliseconds();
+
+        if (stableResult.fifoViolations != 0 || packedResult.fifoViolations != 0 || stableResult.checksum != packedResult.checksum) {
+            std::cout << "stable heaps did not dispatch in FIFO order\n";
+        }
+        sink = sink + stableResult.checksum + unstableResult.checksum;
+
+        std::vector<std::string> indexCol { "StableHeap", "PackedStableHeap", "Heap (unstable)" };
+        std::vector<std::string> headers { "time", "throughput", "FIFO violations" };
+        std::vector<std::vector<std::string>> cells {
+            { formatMilliseconds(stableMs), formatThroughput(n, stableMs), std::to_string(stableResult.fifoViolations) },
+            { formatMilliseconds(packedMs), formatThroughput(n, packedMs), std::to_string(packedResult.fifoViolations) },
+            { formatMilliseconds(unstableMs), formatThroughput(n, unstableMs), std::to_string(unstableResult.fifoViolations) },
+        };
+
+        std::cout << n << " tasks, " << priorityLevels << " priority levels\n";
+        Utils::PrintTable(indexCol, headers, cells);
+    }
+
+}
+
+#endif //DATASTRUCTUREIMPLEMENTATIONS_STABLEHEAPBENCHMARK_HPP
@@ -0,0 +1,156 @@
+#ifndef DATASTRUCTUREIMPLEMENTATIONS_TIMERWHEELBENCHMARK_HPP
+#define DATASTRUCTUREIMPLEMENTATIONS_TIMERWHEELBENCHMARK_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+#include "BenchmarkUtils.hpp"
+#include "../DataStructures/Heap.hpp"
+#include "../SystemDesign/TimerWheel.hpp"
+#include "../Utils/Stopwatch.hpp"
+#include "../Utils/PrintTable.hpp"
+
+namespace Benchmark::TimerWheelCancel {
+
+    /** 一个定时器的生命周期：第 scheduledAt 个 tick 安排，延迟 delay, cancelAt 为 0 表示不取消 */
+    struct TimerEvent {
+        uint64_t scheduledAt;
+        uint64_t delay;
+        uint64_t cancelAt;
+    };
+
+    /** 预先生成全部事件，两种实现回放的是同一份事件序列 */
+    struct Workload {
+        std::vector<TimerEvent> timers;
+
+        /** 第 t 个 tick 要安排的定时器是 timers[scheduleBegin[t], scheduleBegin[t + 1]) */
+        std::vector<size_t> scheduleBegin;
+
+        /** 第 t 个 tick 要取消的定时器编号 */
+        std::vector<std::vector<uint32_t>> cancels;
+
+        uint64_t tickCount;
+    };
+
+    Workload makeWorkload(size_t n, size_t perTick, uint64_t maxDelay, double cancelRatio) {
+        std::mt19937_64 engine { 20221017 };
+        std::uniform_int_distribution<uint64_t> delayDistribution { 1, maxDelay };
+        std::uniform_real_distribution<double> coin { 0.0, 1.0 };
+
+        Workload workload;
+        workload.tickCount = (n + perTick - 1) / perTick + maxDelay + 1;
+        workload.cancels.resize(workload.tickCount);
+        for (size_t i = 0; i < n; ++i) {
+            uint64_t scheduledAt = i / perTick;
+            uint64_t delay = delayDistribution(engine);
+            uint64_t cancelAt = 0;
+            if (coin(engine) < cancelRatio) {
+                // 在到期之前的某个 tick 取消，比如连接在超时之前就正常关闭了
+                cancelAt = scheduledAt + std::uniform_int_distribution<uint64_t> { 0, delay - 1 }(engine);
+                workload.cancels[cancelAt].push_back(static_cast<uint32_t>(i));
+            }
+            workload.timers.push_back({ scheduledAt, delay, cancelAt });
+        }
+
+        workload.scheduleBegin.assign(workload.tickCount + 1, n);
+        for (size_t i = n; i > 0; --i) {
+            workload.scheduleBegin[workload.timers[i - 1].scheduledAt] = i - 1;
+        }
+        for (size_t t = workload.tickCount; t > 0; --t) {
+            workload.scheduleBegin[t - 1] = std::min(workload.scheduleBegin[t - 1], workload.scheduleBegin[t]);
+        }
+
+        return workload;
+    }
+
+    /**
+     * 现在的做法：Heap 没有取消操作，只能给被取消的定时器打上墓碑，等它浮到堆顶时再丢弃，
+     * 所以被取消的定时器照样占着堆的空间，照样要付出插入和弹出的代价。
+     */
+    std::pair<double, size_t> replayWithHeap(const Workload &workload, size_t &peakSize) {
+        Utils::Stopwatch stopwatch;
+        Heap<std::pair<uint64_t, uint32_t>, std::greater<>> heap;
+        std::vector<bool> cancelled (workload.timers.size(), false);
+        size_t fired = 0;
+        peakSize = 0;
+        for (uint64_t tick = 0; tick < workload.tickCount; ++tick) {
+            for (size_t i = workload.scheduleBegin[tick]; i < workload.scheduleBegin[tick + 1]; ++i) {
+                const TimerEvent &timer = workload.timers[i];
+                heap.insert({ timer.scheduledAt + timer.delay, static_cast<uint32_t>(i) });
+            }
+            for (uint32_t i : workload.cancels[tick]) {
+                cancelled[i] = true;
+            }
+            peakSize = std::max(peakSize, heap.size());
+
+            while (!heap.empty() && heap.topRef().first <= tick) {
+                if (!cancelled[heap.topRef().second]) {
+                    ++fired;
+                }
+                heap.pop();
+            }
+        }
+
+        return { stopwatch.elapsedMilliseconds(), fired };
+    }
+
+    /** 时间轮：取消是 O(1) 的真正删除 */
+    std::pair<double, size_t> replayWithTimerWheel(const Workload &workload, size_t &peakSize) {
+        Utils::Stopwatch stopwatch;
+        SystemDesign::Timer::TimerWheel<uint32_t> wheel;
+        std::vector<SystemDesign::Timer::TimerId> ids (workload.timers.size());
+        size_t fired = 0;
+        peakSize = 0;
+        for (uint64_t tick = 0; tick < workload.tickCount; ++tick) {
+            for (size_t i = workload.scheduleBegin[tick]; i < workload.scheduleBegin[tick + 1]; ++i) {
+                // wheel.now() == tick, 到期时间和 Heap 的版本一致
+                ids[i] = wheel.schedule(workload.timers[i].delay, static_cast<uint32_t>(i));
+            }
+            for (uint32_t i : workload.cancels[tick]) {
+                wheel.cancel(ids[i]);
+            }
+            peakSize = std::max(peakSize, wheel.size());
+
+            wheel.advance(1, [&fired](SystemDesign::Timer::TimerId, uint32_t &) {
+                ++fired;
+            });
+        }
+
+        return { stopwatch.elapsedMilliseconds(), fired };
+    }
+
+    /**
+     * n 个连接超时定时器，每个 tick 安排 perTick 个，延迟在 [1, 60000] 个 tick 中均匀分布，其中 90% 在到期之前被取消。
+     * n 为 0 时默认 n = 5,000,000.
+     */
+    void run(size_t n) {
+        if (n == 0) {
+            n = 5'000'000;
+        }
+
+        Workload workload = makeWorkload(n, 1000, 60'000, 0.9);
+
+        std::vector<std::string> indexCol;
+        std::vector<std::string> headers { "time", "throughput", "peak queued", "fired" };
+        std::vector<std::vector<std::string>> cells;
+        size_t peakSize = 0;
+
+        auto [heapMs, heapFired] = replayWithHeap(workload, peakSize);
+        indexCol.push_back("Heap + tombstones");
+        cells.push_back({ formatMilliseconds(heapMs), formatThroughput(n, heapMs), std::to_string(peakSize), std::to_string(heapFired) });
+
+        auto [wheelMs, wheelFired] = replayWithTimerWheel(workload, peakSize);
+        indexCol.push_back("TimerWheel");
+        cells.push_back({ formatMilliseconds(wheelMs), formatThroughput(n, wheelMs), std::to_string(peakSize), std::to_string(wheelFired) });
+
+        std::cout << n << " timers over " << workload.tickCount << " ticks, 90% cancelled before expiry\n";
+        Utils::PrintTable(indexCol, headers, cells);
+    }
+
+}
+
+#endif //DATASTRUCTUREIMPLEMENTATIONS_TIMERWHEELBENCHMARK_HPP
@@ -0,0 +1,131 @@
+#ifndef DATASTRUCTUREIMPLEMENTATIONS_TOPKBENCHMARK_HPP
+#define DATASTRUCTUREIMPLEMENTATIONS_TOPKBENCHMARK_HPP
+
+#include <algorithm>
+#include <compare>
+#include <cstdint>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include "BenchmarkUtils.hpp"
+#include "../DataStructures/Heap.hpp"
+#include "../DataStructures/TopK.hpp"
+#include "../Utils/Stopwatch.hpp"
+#include "../Utils/PrintTable.hpp"
+
+namespace Benchmark::TopKFilter {
+
+    constexpr size_t K = 1000;
+
+    /** 非算术类型的分数：分数相同时按 id 比较，TopK 对它走的是标量的预过滤 */
+    struct Record {
+        uint32_t score;
+        uint32_t id;
+
+        auto operator<=>(const Record &) const = default;
+
+        explicit operator uint64_t() const {
+            return (static_cast<uint64_t>(this->score) << 32) | this->id;
+        }
+    };
+
+    /** 直接用一个小顶堆：不满 K 个就插入，否则和堆顶比较，更大就 pop 再 insert */
+    template <typename Score>
+    std::vector<Score> naiveHeap(const std::vector<Score> &scores) {
+        Heap<Score, std::greater<>> heap;
+        for (const Score &score : scores) {
+            if (heap.size() < K) {
+                heap.insert(score);
+            } else if (heap.topRef() < score) {
+                heap.pop();
+                heap.insert(score);
+            }
+        }
+
+        std::vector<Score> result;
+        heap.popK(heap.size(), std::back_inserter(result));
+        std::reverse(result.begin(), result.end());
+        return result;
+    }
+
+    /** 逐个调用 TopK::push */
+    template <typename Score>
+    std::vector<Score> perElement(const std::vector<Score> &scores) {
+        TopK<Score, K> topK;
+        for (const Score &score : scores) {
+            topK.push(score);
+        }
+
+        return topK.extractSorted();
+    }
+
+    /** 调用 TopK::pushRange, 整组不合格的输入被成批跳过 */
+    template <typename Score>
+    std::vector<Score> blockFiltered(const std::vector<Score> &scores) {
+        TopK<Score, K> topK;
+        topK.pushRange(scores);
+        return topK.extractSorted();
+    }
+
+    template <typename Score>
+    void measure(const std::string &name, const std::vector<Score> &scores,
+                 std::vector<std::string> &indexCol, std::vector<std::vector<std::string>> &cells) {
+        std::vector<std::string> row;
+        std::vector<Score> expected;
+        for (auto variant : { naiveHeap<Score>, perElement<Score>, blockFiltered<Score> }) {
+            Utils::Stopwatch stopwatch;
+            std::vector<Score> result = variant(scores);
+            double ms = stopwatch.elapsedMilliseconds();
+            if (expected.empty()) {
+                expected = result;
+            } else if (result != expected) {
+                std::cout << "mismatch in " << name << "\n";
+            }
+            sink = sink + static_cast<uint64_t>(result.front());
+            row.push_back(formatThroughput(scores.size(), ms));
+        }
+
+        indexCol.push_back(name);
+        cells.push_back(std::move(row));
+    }
+
+    /**
+     * 在 n 个随机分数中保留最大的 K = 1000 个，对比直接用 Heap、逐个 TopK::push 和分组预过滤的 pushRange.
+     * 随机输入下门槛很快升高，绝大多数元素都会被丢弃，测的主要是丢弃的代价。
+     * 分数依次是 uint32、float 和一个非算术类型的 Record, 前两种预过滤是向量比较，Record 是标量循环。
+     * n 为 0 时默认 n = 50,000,000.
+     */
+    void run(size_t n) {
+        if (n == 0) {
+            n = 50'000'000;
+        }
+
+        std::vector<std::string> indexCol;
+        std::vector<std::string> headers { "Heap", "TopK::push", "TopK::pushRange" };
+        std::vector<std::vector<std::string>> cells;
+
+        auto integers = makeRandomIntegers<uint32_t>(n, 0, UINT32_MAX, 1);
+        measure("uint32", integers, indexCol, cells);
+
+        std::vector<float> floats (integers.begin(), integers.end());
+        for (float &score : floats) {
+            score /= static_cast<float>(UINT32_MAX);
+        }
+        measure("float", floats, indexCol, cells);
+        floats = std::vector<float>();
+
+        std::vector<Record> records;
+        records.reserve(n);
+        for (uint32_t i = 0; i < n; ++i) {
+            records.push_back(Record { integers[i], i });
+        }
+        measure("record (non-arithmetic)", records, indexCol, cells);
+
+        std::cout << "keep top " << K << " of " << n << " random scores\n";
+        Utils::PrintTable(indexCol, headers, cells);
+    }
+
+}
+
+#endif //DATASTRUCTUREIMPLEMENTATIONS_TOPKBENCHMARK_HPP
@@ -0,0 +1,66 @@
+#include <iostream>
+#include <string>
+#include <functional>
+#include <map>
+#include "HeapSiftBenchmark.hpp"
+#include "HeapComparatorBenchmark.hpp"
+#include "HeapBulkInsertBenchmark.hpp"
+#include "HeapStatsBenchmark.hpp"
+#include "DaryHeapBenchmark.hpp"
+#include "MultiQueueBenchmark.hpp"
+#include "TopKBenchmark.hpp"
+#include "ExternalHeapBenchmark.hpp"
+#include "BucketedHeapBenchmark.hpp"
+#include "TimerWheelBenchmark.hpp"
+#include "BucketQueueBenchmark.hpp"
+#include "KWayMergeBenchmark.hpp"
+#include "DijkstraBenchmark.hpp"
+#include "PointToPointBenchmark.hpp"
+#include "DeltaSteppingBenchmark.hpp"
+#include "DistanceTableBenchmark.hpp"
+#include "MeldableHeapBenchmark.hpp"
+#include "MinMaxHeapBenchmark.hpp"
+#include "PersistentHeapBenchmark.hpp"
+#include "StableHeapBenchmark.hpp"
+
+/**
+ * 性能测试入口，用法：benchmark <名称> [规模]
+ * 规模省略或者为 0 时，各个测试使用自己的默认规模。
+ * 记得用 Release 模式构建（cmake -DCMAKE_BUILD_TYPE=Release），否则测出来的数字没有意义。
+ */
+int main(int argc, char *argv[]) {
+    std::map<std::string, std::function<void (size_t)>> benchmarks {
+        { "heap-sift", Benchmark::HeapSift::run },
+        { "heap-comparator", Benchmark::HeapComparator::run },
+        { "heap-bulk-insert", Benchmark::HeapBulkInsert::run },
+        { "heap-stats", Benchmark::HeapInstrumentation::run },
+        { "dary-heap", Benchmark::DaryHeapArity::run },
+        { "multi-queue", Benchmark::MultiQueueScaling::run },
+        { "top-k", Benchmark::TopKFilter::run },
+        { "external-heap", Benchmark::ExternalHeapSpill::run },
+        { "bucketed-heap", Benchmark::ApproximateHeap::run },
+        { "timer-wheel", Benchmark::TimerWheelCancel::run },
+        { "bucket-queue", Benchmark::BucketQueueTrace::run },
+        { "k-way-merge", Benchmark::KWayMergeShards::run },
+        { "dijkstra", Benchmark::DijkstraQueue::run },
+        { "point-to-point", Benchmark::PointToPoint::run },
+        { "delta-stepping", Benchmark::DeltaSteppingScaling::run },
+        { "distance-table", Benchmark::DistanceTable::run },
+        { "meldable-heap", Benchmark::MeldableHeap::run },
+        { "min-max-heap", Benchmark::BestNTracker::run },
+        { "persistent-heap", Benchmark::SpeculativeSchedule::run },
+        { "stable-heap", Benchmark::FairShareDispatch::run },
+    };
+
+    if (argc < 2 || !benchmarks.contains(argv[1])) {
+        std::cout << "usage: " << argv[0] << " <name> [n]\navailable benchmarks:\n";
+        for (const auto &entry : benchmarks) {
+            std::cout << "  " << entry.first << "\n";
+        }
+        return 1;
+    }
+
+    size_t n = argc >= 3 ? std::stoull(argv[2]) : 0;
+    benchmarks[argv[1]](n);
+    return 0;
+}
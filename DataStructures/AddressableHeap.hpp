@@ -0,0 +1,293 @@
+#ifndef DATASTRUCTUREIMPLEMENTATIONS_ADDRESSABLEHEAP_HPP
+#define DATASTRUCTUREIMPLEMENTATIONS_ADDRESSABLEHEAP_HPP
+
+#include <cassert>
+#include <functional>
+#include <limits>
+#include <utility>
+#include <vector>
+
+/**
+ * 可寻址的堆：insert 返回一个句柄，之后可以凭句柄在 O(log n) 内修改或者删除对应的元素。
+ *
+ * 排序准则 Compare 的约定和 Heap<T, Compare> 一致：compare(a, b) 为 true 表示 a 的优先级低于 b.
+ * increaseKey / decreaseKey 的"大小"是相对于 Compare 而言的（和 Boost.Heap 的约定相同）：
+ * - increaseKey: 新 key 的优先级不低于旧 key, 元素只会往堆顶方向上浮；
+ * - decreaseKey: 新 key 的优先级不高于旧 key, 元素只会往叶子方向下沉；
+ * 所以用 std::greater<> 得到的小顶堆上做 Dijkstra 时，把距离改小要调用的是 increaseKey.
+ *
+ * 实现上除了堆的存储区域之外，还维护了一张 句柄 -> 存储位置 的表，所有的上浮、下沉在移动元素的同时更新这张表。
+ * 句柄在元素被 pop 或者 erase 之前一直有效，之后可能被新插入的元素复用。
+ */
+template <typename T, typename Compare = std::less<>>
+class AddressableHeap {
+public:
+    /** 元素的句柄 */
+    using Handle = size_t;
+
+    /** 构造一个空堆，可以指定 key 的排序准则 */
+    explicit AddressableHeap(const Compare& compare = Compare());
+
+    /** 不允许复制 */
+    AddressableHeap(const AddressableHeap& rhs) = delete;
+
+    /** 可移动 */
+    AddressableHeap(AddressableHeap&& rhs) noexcept = default;
+
+    /** 插入一个元素，返回它的句柄 */
+    Handle insert(const T& key);
+
+    /** 查看堆顶部的元素 */
+    [[nodiscard]] T top() const;
+
+    /** 查看堆顶部的元素的句柄 */
+    [[nodiscard]] Handle topHandle() const;
+
+    /** 弹出堆顶部的元素，它的句柄随之失效 */
+    void pop();
+
+    /** 查看句柄对应的元素 */
+    [[nodiscard]] const T& get(Handle handle) const;
+
+    /** 句柄当前是否指向堆中的一个元素 */
+    [[nodiscard]] bool contains(Handle handle) const;
+
+    /** 把句柄对应的元素替换为一个优先级不低于它的新 key */
+    void increaseKey(Handle handle, const T& key);
+
+    /** 把句柄对应的元素替换为一个优先级不高于它的新 key */
+    void decreaseKey(Handle handle, const T& key);
+
+    /** 把句柄对应的元素替换为任意的新 key */
+    void update(Handle handle, const T& key);
+
+    /** 删除句柄对应的元素，句柄随之失效 */
+    void erase(Handle handle);
+
+    /** 清除堆的所有元素，所有句柄随之失效 */
+    void clear();
+
+    /** 检查这个堆是否是空堆 */
+    [[nodiscard]] bool empty() const;
+
+    /** 返回队列长度 */
+    [[nodiscard]] size_t size() const;
+
+private:
+    /** 存储区域中的一项：key 和它的句柄放在一起，移动元素时就能顺手更新位置表 */
+    struct Entry {
+        T key;
+        Handle handle;
+    };
+
+    /** 位置表中表示"该句柄空闲"的值 */
+    static constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+    /** 堆的存储区域 */
+    std::vector<Entry> _store;
+
+    /** 句柄 -> 该句柄的元素在 _store 中的下标 */
+    std::vector<size_t> positions;
+
+    /** 可以复用的句柄 */
+    std::vector<Handle> freeHandles;
+
+    /** 比较器 */
+    [[no_unique_address]] Compare compare;
+
+    /** 把 entry 放到 _store[nodeOffset], 同时更新位置表 */
+    void place(size_t nodeOffset, Entry&& entry);
+
+    /** 让 nodeOffset 指向的节点上浮，直至堆性恢复 */
+    void reHeapifyByFloat(size_t nodeOffset);
+
+    /** 让 nodeOffset 指向的节点下沉，直至堆性恢复 */
+    void reHeapifyBySink(size_t nodeOffset);
+
+    /** 删除 nodeOffset 处的元素并回收它的句柄 */
+    void removeAt(size_t nodeOffset);
+
+    /** 比较两个 key，返回 true 当且仅当 lhs 的优先级低于 rhs */
+    [[nodiscard]] bool comparePriorityLessThan(const T& lhs, const T& rhs) const;
+};
+
+template <typename T, typename Compare>
+AddressableHeap<T, Compare>::AddressableHeap(const Compare &_compare)
+: _store(), positions(), freeHandles(), compare(_compare) { }
+
+template <typename T, typename Compare>
+typename AddressableHeap<T, Compare>::Handle AddressableHeap<T, Compare>::insert(const T &key) {
+    Handle handle;
+    if (!this->freeHandles.empty()) {
+        handle = this->freeHandles.back();
+        this->freeHandles.pop_back();
+    } else {
+        handle = this->positions.size();
+        this->positions.push_back(npos);
+    }
+
+    this->_store.push_back(Entry { key, handle });
+    this->positions[handle] = this->_store.size() - 1;
+    this->reHeapifyByFloat(this->_store.size() - 1);
+    return handle;
+}
+
+template <typename T, typename Compare>
+T AddressableHeap<T, Compare>::top() const {
+    return this->_store[0].key;
+}
+
+template <typename T, typename Compare>
+typename AddressableHeap<T, Compare>::Handle AddressableHeap<T, Compare>::topHandle() const {
+    return this->_store[0].handle;
+}
+
+template <typename T, typename Compare>
+void AddressableHeap<T, Compare>::pop() {
+    if (this->_store.empty()) {
+        return;
+    }
+
+    this->removeAt(0);
+}
+
+template <typename T, typename Compare>
+const T &AddressableHeap<T, Compare>::get(Handle handle) const {
+    assert((this->contains(handle)));
+    return this->_store[this->positions[handle]].key;
+}
+
+template <typename T, typename Compare>
+bool AddressableHeap<T, Compare>::contains(Handle handle) const {
+    return handle < this->positions.size() && this->positions[handle] != npos;
+}
+
+template <typename T, typename Compare>
+void AddressableHeap<T, Compare>::increaseKey(Handle handle, const T &key) {
+    assert((this->contains(handle)));
+    size_t nodeOffset = this->positions[handle];
+    assert((!this->comparePriorityLessThan(key, this->_store[nodeOffset].key)));
+    this->_store[nodeOffset].key = key;
+    this->reHeapifyByFloat(nodeOffset);
+}
+
+template <typename T, typename Compare>
+void AddressableHeap<T, Compare>::decreaseKey(Handle handle, const T &key) {
+    assert((this->contains(handle)));
+    size_t nodeOffset = this->positions[handle];
+    assert((!this->comparePriorityLessThan(this->_store[nodeOffset].key, key)));
+    this->_store[nodeOffset].key = key;
+    this->reHeapifyBySink(nodeOffset);
+}
+
+template <typename T, typename Compare>
+void AddressableHeap<T, Compare>::update(Handle handle, const T &key) {
+    assert((this->contains(handle)));
+    size_t nodeOffset = this->positions[handle];
+    bool goesUp = this->comparePriorityLessThan(this->_store[nodeOffset].key, key);
+    this->_store[nodeOffset].key = key;
+    if (goesUp) {
+        this->reHeapifyByFloat(nodeOffset);
+    } else {
+        this->reHeapifyBySink(nodeOffset);
+    }
+}
+
+template <typename T, typename Compare>
+void AddressableHeap<T, Compare>::erase(Handle handle) {
+    assert((this->contains(handle)));
+    this->removeAt(this->positions[handle]);
+}
+
+template <typename T, typename Compare>
+void AddressableHeap<T, Compare>::removeAt(size_t nodeOffset) {
+    Handle handle = this->_store[nodeOffset].handle;
+    this->positions[handle] = npos;
+    this->freeHandles.push_back(handle);
+
+    size_t lastOffset = this->_store.size() - 1;
+    if (nodeOffset == lastOffset) {
+        this->_store.pop_back();
+        return;
+    }
+
+    // 用最后一个元素填补空出来的位置，它可能需要上浮也可能需要下沉
+    Entry last = std::move(this->_store.back());
+    this->_store.pop_back();
+    bool goesUp = nodeOffset > 0 && this->comparePriorityLessThan(this->_store[(nodeOffset - 1) / 2].key, last.key);
+    this->place(nodeOffset, std::move(last));
+    if (goesUp) {
+        this->reHeapifyByFloat(nodeOffset);
+    } else {
+        this->reHeapifyBySink(nodeOffset);
+    }
+}
+
+template <typename T, typename Compare>
+void AddressableHeap<T, Compare>::place(size_t nodeOffset, Entry &&entry) {
+    this->positions[entry.handle] = nodeOffset;
+    this->_store[nodeOffset] = std::move(entry);
+}
+
+template <typename T, typename Compare>
+void AddressableHeap<T, Compare>::reHeapifyByFloat(size_t nodeOffset) {
+    Entry entry = std::move(this->_store[nodeOffset]);
+    while (nodeOffset > 0) {
+        size_t parentOffset = (nodeOffset - 1) / 2;
+        if (!this->comparePriorityLessThan(this->_store[parentOffset].key, entry.key)) {
+            break;
+        }
+
+        this->place(nodeOffset, std::move(this->_store[parentOffset]));
+        nodeOffset = parentOffset;
+    }
+
+    this->place(nodeOffset, std::move(entry));
+}
+
+template <typename T, typename Compare>
+void AddressableHeap<T, Compare>::reHeapifyBySink(size_t nodeOffset) {
+    const size_t storeSize = this->_store.size();
+    Entry entry = std::move(this->_store[nodeOffset]);
+    size_t childOffset = nodeOffset * 2 + 1;
+    while (childOffset < storeSize) {
+        size_t rightOffset = childOffset + 1;
+        if (rightOffset < storeSize && this->comparePriorityLessThan(this->_store[childOffset].key, this->_store[rightOffset].key)) {
+            childOffset = rightOffset;
+        }
+
+        if (!this->comparePriorityLessThan(entry.key, this->_store[childOffset].key)) {
+            break;
+        }
+
+        this->place(nodeOffset, std::move(this->_store[childOffset]));
+        nodeOffset = childOffset;
+        childOffset = nodeOffset * 2 + 1;
+    }
+
+    this->place(nodeOffset, std::move(entry));
+}
+
+template <typename T, typename Compare>
+bool AddressableHeap<T, Compare>::comparePriorityLessThan(const T &lhs, const T &rhs) const {
+    return this->compare(lhs, rhs);
+}
+
+template <typename T, typename Compare>
+void AddressableHeap<T, Compare>::clear() {
+    this->_store.clear();
+    this->positions.clear();
+    this->freeHandles.clear();
+}
+
+template <typename T, typename Compare>
+bool AddressableHeap<T, Compare>::empty() const {
+    return this->_store.empty();
+}
+
+template <typename T, typename Compare>
+size_t AddressableHeap<T, Compare>::size() const {
+    return this->_store.size();
+}
+
+#endif //DATASTRUCTUREIMPLEMENTATIONS_ADDRESSABLEHEAP_HPP
@@ -0,0 +1,225 @@
+#ifndef DATASTRUCTUREIMPLEMENTATIONS_BUCKETQUEUE_HPP
+#define DATASTRUCTUREIMPLEMENTATIONS_BUCKETQUEUE_HPP
+
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cstdint>
+#include <functional>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+#include "NodePool.hpp"
+
+/**
+ * 桶队列：优先级是 [0, Levels) 中的小整数时，代替 Heap 的 O(1) 优先队列，接口和 Heap 保持一致。
+ *
+ * 主要思路：
+ * 每个优先级一个桶，桶是一条侵入式的单链表（带尾指针），同一个桶里先进先出；
+ * 另有一张位图记录哪些桶非空，位图本身再用一个 64 位的摘要字记录哪些字非空，
+ * 找优先级最高的非空桶只需要两次 countl_zero, 所以 insert / top / pop 都是 O(1), 不做任何比较。
+ * Priority 把元素映射到 [0, Levels), 数值越大越先弹出，和 Heap 默认的大顶堆一致。
+ * 链表节点从 NodePool 中分配。
+ */
+template <typename T, size_t Levels = 256, typename Priority = std::identity>
+class BucketQueue {
+    static_assert(Levels >= 1 && Levels <= 64 * 64, "BucketQueue: Levels must be in [1, 4096]");
+
+public:
+    /** 构造一个空队列，Priority 把元素映射到 [0, Levels) */
+    explicit BucketQueue(const Priority& priority = Priority());
+
+    /** 不允许复制 */
+    BucketQueue(const BucketQueue& rhs) = delete;
+
+    ~BucketQueue();
+
+    /** 插入一个元素 */
+    void insert(const T& key);
+
+    /** 以移动的方式插入一个元素 */
+    void insert(T&& key);
+
+    /** 用 args 构造一个元素再插入 */
+    template <typename... Args>
+    void emplace(Args&&... args);
+
+    /** 逐个插入 range 中的所有元素 */
+    template <std::ranges::input_range Range>
+    void pushBulk(Range&& range);
+
+    /** 查看队首的元素 */
+    T top() const;
+
+    /** 查看队首的元素，返回常量引用，引用在该元素被弹出之前有效 */
+    const T& topRef() const;
+
+    /** 弹出队首的元素 */
+    void pop();
+
+    /** 弹出队首的元素并把它移动出来返回，队列不得为空 */
+    T extract();
+
+    /** 清除所有元素 */
+    void clear();
+
+    /** 检查这个队列是否为空 */
+    [[nodiscard]] bool empty() const;
+
+    /** 返回队列长度 */
+    [[nodiscard]] size_t size() const;
+
+private:
+    static constexpr size_t wordCount = (Levels + 63) / 64;
+
+    struct Node {
+        template <typename... Args>
+        explicit Node(Args&&... args) : key(std::forward<Args>(args)...), next(nullptr) { }
+
+        T key;
+        Node* next;
+    };
+
+    std::array<Node*, Levels> heads;
+    std::array<Node*, Levels> tails;
+
+    /** 第 i 位为 1 表示第 i 个桶非空 */
+    std::array<uint64_t, wordCount> bitmap;
+
+    /** 第 w 位为 1 表示 bitmap[w] 非零 */
+    uint64_t summary;
+
+    size_t count;
+    NodePool<Node> pool;
+    [[no_unique_address]] Priority priority;
+
+    /** 把 node 挂到它的桶的末尾 */
+    void append(Node* node);
+
+    /** 优先级最高的非空桶，队列不得为空 */
+    [[nodiscard]] size_t topLevel() const;
+
+    /** 把 level 号桶的第一个节点摘下来返回 */
+    Node* unlinkFront(size_t level);
+};
+
+template <typename T, size_t Levels, typename Priority>
+BucketQueue<T, Levels, Priority>::BucketQueue(const Priority &_priority)
+: heads(), tails(), bitmap(), summary(0), count(0), pool(), priority(_priority) {
+    this->heads.fill(nullptr);
+    this->tails.fill(nullptr);
+}
+
+template <typename T, size_t Levels, typename Priority>
+BucketQueue<T, Levels, Priority>::~BucketQueue() {
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+        this->clear();
+    }
+}
+
+template <typename T, size_t Levels, typename Priority>
+void BucketQueue<T, Levels, Priority>::append(Node *node) {
+    size_t level = static_cast<size_t>(std::invoke(this->priority, node->key));
+    assert((level < Levels));
+    if (this->tails[level]) {
+        this->tails[level]->next = node;
+    } else {
+        this->heads[level] = node;
+        this->bitmap[level / 64] |= uint64_t(1) << (level % 64);
+        this->summary |= uint64_t(1) << (level / 64);
+    }
+    this->tails[level] = node;
+    ++this->count;
+}
+
+template <typename T, size_t Levels, typename Priority>
+void BucketQueue<T, Levels, Priority>::insert(const T &key) {
+    this->append(this->pool.create(key));
+}
+
+template <typename T, size_t Levels, typename Priority>
+void BucketQueue<T, Levels, Priority>::insert(T &&key) {
+    this->append(this->pool.create(std::move(key)));
+}
+
+template <typename T, size_t Levels, typename Priority>
+template <typename... Args>
+void BucketQueue<T, Levels, Priority>::emplace(Args &&...args) {
+    this->append(this->pool.create(std::forward<Args>(args)...));
+}
+
+template <typename T, size_t Levels, typename Priority>
+template <std::ranges::input_range Range>
+void BucketQueue<T, Levels, Priority>::pushBulk(Range &&range) {
+    for (auto &&key : range) {
+        this->insert(std::forward<decltype(key)>(key));
+    }
+}
+
+template <typename T, size_t Levels, typename Priority>
+size_t BucketQueue<T, Levels, Priority>::topLevel() const {
+    assert((this->summary != 0));
+    size_t word = 63 - static_cast<size_t>(std::countl_zero(this->summary));
+    return word * 64 + 63 - static_cast<size_t>(std::countl_zero(this->bitmap[word]));
+}
+
+template <typename T, size_t Levels, typename Priority>
+typename BucketQueue<T, Levels, Priority>::Node *BucketQueue<T, Levels, Priority>::unlinkFront(size_t level) {
+    Node* node = this->heads[level];
+    this->heads[level] = node->next;
+    if (!node->next) {
+        this->tails[level] = nullptr;
+        this->bitmap[level / 64] &= ~(uint64_t(1) << (level % 64));
+        if (this->bitmap[level / 64] == 0) {
+            this->summary &= ~(uint64_t(1) << (level / 64));
+        }
+    }
+    --this->count;
+    return node;
+}
+
+template <typename T, size_t Levels, typename Priority>
+T BucketQueue<T, Levels, Priority>::top() const {
+    return this->heads[this->topLevel()]->key;
+}
+
+template <typename T, size_t Levels, typename Priority>
+const T &BucketQueue<T, Levels, Priority>::topRef() const {
+    return this->heads[this->topLevel()]->key;
+}
+
+template <typename T, size_t Levels, typename Priority>
+void BucketQueue<T, Levels, Priority>::pop() {
+    if (this->count == 0) {
+        return;
+    }
+
+    this->pool.destroy(this->unlinkFront(this->topLevel()));
+}
+
+template <typename T, size_t Levels, typename Priority>
+T BucketQueue<T, Levels, Priority>::extract() {
+    Node* node = this->unlinkFront(this->topLevel());
+    T key = std::move(node->key);
+    this->pool.destroy(node);
+    return key;
+}
+
+template <typename T, size_t Levels, typename Priority>
+void BucketQueue<T, Levels, Priority>::clear() {
+    while (this->summary != 0) {
+        this->pool.destroy(this->unlinkFront(this->topLevel()));
+    }
+}
+
+template <typename T, size_t Levels, typename Priority>
+bool BucketQueue<T, Levels, Priority>::empty() const {
+    return this->count == 0;
+}
+
+template <typename T, size_t Levels, typename Priority>
+size_t BucketQueue<T, Levels, Priority>::size() const {
+    return this->count;
+}
+
+#endif //DATASTRUCTUREIMPLEMENTATIONS_BUCKETQUEUE_HPP
@@ -0,0 +1,261 @@
+#ifndef DATASTRUCTUREIMPLEMENTATIONS_BUCKETEDHEAP_HPP
+#define DATASTRUCTUREIMPLEMENTATIONS_BUCKETEDHEAP_HPP
+
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <ranges>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "Heap.hpp"
+
+/**
+ * 近似优先队列：只保证弹出的元素"大致"是优先级最高的，换取更低的代价，接口和 Heap 保持一致。
+ *
+ * 主要思路：
+ * Priority 把元素映射成一个数值优先级（默认是元素本身），数值越大越先弹出，和 Heap 默认的大顶堆一致。
+ * 按 floor(priority / bucketWidth) 把元素分桶，桶内不排序（后进先出），
+ * 另用一个 Heap 维护非空的桶的编号，所以只有"桶变空 / 桶变非空"时才需要一次 O(log B) 的堆操作，
+ * 其余的 insert / pop 都是哈希表查找加上 vector 的 push_back / pop_back.
+ *
+ * 误差：弹出的元素和当前真正优先级最高的元素相差不到 bucketWidth.
+ * bucketWidth 越大桶越少、越快，也越不精确；bucketWidth 小到每个桶只有一个元素时就退化成了 Heap 加一个哈希表。
+ */
+template <typename T, typename Priority = std::identity>
+class BucketedHeap {
+public:
+    /** 按照桶宽 bucketWidth 构造一个空堆，Priority 把元素映射成数值优先级 */
+    explicit BucketedHeap(double bucketWidth, const Priority& priority = Priority());
+
+    /** 不允许复制 */
+    BucketedHeap(const BucketedHeap& rhs) = delete;
+
+    /** 可移动 */
+    BucketedHeap(BucketedHeap&& rhs) noexcept = default;
+
+    /** 插入一个元素 */
+    void insert(const T& key);
+
+    /** 以移动的方式插入一个元素 */
+    void insert(T&& key);
+
+    /** 用 args 构造一个元素再插入 */
+    template <typename... Args>
+    void emplace(Args&&... args);
+
+    /** 逐个插入 range 中的所有元素 */
+    template <std::ranges::input_range Range>
+    void pushBulk(Range&& range);
+
+    /** 查看堆顶部的元素，即优先级最高的桶中的某一个元素 */
+    T top() const;
+
+    /** 查看堆顶部的元素，返回常量引用，引用在堆下一次被修改之前有效 */
+    const T& topRef() const;
+
+    /** 弹出堆顶部的元素 */
+    void pop();
+
+    /** 弹出堆顶部的元素并把它移动出来返回，堆不得为空 */
+    T extract();
+
+    /** 清除堆的所有元素 */
+    void clear();
+
+    /** 检查这个堆是否是空堆 */
+    [[nodiscard]] bool empty() const;
+
+    /** 返回元素的个数 */
+    [[nodiscard]] size_t size() const;
+
+    /** 桶宽，也是弹出顺序的误差上界 */
+    [[nodiscard]] double bucketWidth() const;
+
+private:
+    double width;
+
+    /** 非空的桶，桶变空时就从表里删掉，否则优先级不断漂移（比如时间戳）时表会无限地变大 */
+    std::unordered_map<int64_t, std::vector<T>> buckets;
+
+    /** 删掉的桶留下的几个哈希表节点（连同里面空的 vector）, 新建桶时复用，省去节点的分配和 vector 的扩容 */
+    std::vector<typename std::unordered_map<int64_t, std::vector<T>>::node_type> spareBuckets;
+
+    /** spareBuckets 最多保留的个数 */
+    static constexpr size_t maxSpareBuckets = 8;
+
+    /** 非空的桶的编号，编号越大优先级越高 */
+    Heap<int64_t> nonEmptyBuckets;
+
+    /** 缓存优先级最高的非空桶，省去 top / pop 时的哈希表查找 */
+    std::vector<T>* topBucket;
+
+    size_t count;
+
+    [[no_unique_address]] Priority priority;
+
+    /** 元素所在的桶的编号 */
+    [[nodiscard]] int64_t bucketOf(const T& key) const;
+
+    /** 编号为 bucketIdx 的桶，不存在时新建一个，优先复用 spareBuckets 中的节点 */
+    std::vector<T>& bucketAt(int64_t bucketIdx);
+
+    /** 把桶从表里摘下来，按需收进 spareBuckets */
+    void recycle(typename std::unordered_map<int64_t, std::vector<T>>::iterator bucket);
+
+    /** key 已经放在 bucket 的末尾，按需登记这个桶 */
+    void onInserted(int64_t bucketIdx, std::vector<T>& bucket);
+
+    /** 最高的桶刚刚少了一个元素，变空了就换到下一个非空的桶 */
+    void onRemoved();
+};
+
+template <typename T, typename Priority>
+BucketedHeap<T, Priority>::BucketedHeap(double bucketWidth, const Priority &_priority)
+: width(bucketWidth), buckets(), spareBuckets(), nonEmptyBuckets(), topBucket(nullptr), count(0), priority(_priority) {
+    assert((bucketWidth > 0));
+}
+
+template <typename T, typename Priority>
+int64_t BucketedHeap<T, Priority>::bucketOf(const T &key) const {
+    return static_cast<int64_t>(std::floor(static_cast<double>(std::invoke(this->priority, key)) / this->width));
+}
+
+template <typename T, typename Priority>
+std::vector<T> &BucketedHeap<T, Priority>::bucketAt(int64_t bucketIdx) {
+    auto it = this->buckets.find(bucketIdx);
+    if (it != this->buckets.end()) {
+        return it->second;
+    }
+    if (this->spareBuckets.empty()) {
+        return this->buckets[bucketIdx];
+    }
+
+    auto node = std::move(this->spareBuckets.back());
+    this->spareBuckets.pop_back();
+    node.key() = bucketIdx;
+    return this->buckets.insert(std::move(node)).position->second;
+}
+
+template <typename T, typename Priority>
+void BucketedHeap<T, Priority>::recycle(typename std::unordered_map<int64_t, std::vector<T>>::iterator bucket) {
+    auto node = this->buckets.extract(bucket);
+    if (this->spareBuckets.size() < maxSpareBuckets) {
+        node.mapped().clear();
+        this->spareBuckets.push_back(std::move(node));
+    }
+}
+
+template <typename T, typename Priority>
+void BucketedHeap<T, Priority>::onInserted(int64_t bucketIdx, std::vector<T> &bucket) {
+    ++this->count;
+    if (bucket.size() > 1) {
+        return;
+    }
+
+    // 桶从空变成非空，登记它的编号；如果它成了最高的桶，更新缓存
+    bool becomesTop = this->nonEmptyBuckets.empty() || this->nonEmptyBuckets.topRef() < bucketIdx;
+    this->nonEmptyBuckets.insert(bucketIdx);
+    if (becomesTop) {
+        this->topBucket = &bucket;
+    }
+}
+
+template <typename T, typename Priority>
+void BucketedHeap<T, Priority>::insert(const T &key) {
+    int64_t bucketIdx = this->bucketOf(key);
+    std::vector<T> &bucket = this->bucketAt(bucketIdx);
+    bucket.push_back(key);
+    this->onInserted(bucketIdx, bucket);
+}
+
+template <typename T, typename Priority>
+void BucketedHeap<T, Priority>::insert(T &&key) {
+    int64_t bucketIdx = this->bucketOf(key);
+    std::vector<T> &bucket = this->bucketAt(bucketIdx);
+    bucket.push_back(std::move(key));
+    this->onInserted(bucketIdx, bucket);
+}
+
+template <typename T, typename Priority>
+template <typename... Args>
+void BucketedHeap<T, Priority>::emplace(Args &&...args) {
+    this->insert(T(std::forward<Args>(args)...));
+}
+
+template <typename T, typename Priority>
+template <std::ranges::input_range Range>
+void BucketedHeap<T, Priority>::pushBulk(Range &&range) {
+    for (auto &&key : range) {
+        this->insert(std::forward<decltype(key)>(key));
+    }
+}
+
+template <typename T, typename Priority>
+T BucketedHeap<T, Priority>::top() const {
+    return this->topBucket->back();
+}
+
+template <typename T, typename Priority>
+const T &BucketedHeap<T, Priority>::topRef() const {
+    return this->topBucket->back();
+}
+
+template <typename T, typename Priority>
+void BucketedHeap<T, Priority>::onRemoved() {
+    --this->count;
+    if (!this->topBucket->empty()) {
+        return;
+    }
+
+    // 变空的桶从表里删掉，它的节点留着给以后新建的桶用
+    this->recycle(this->buckets.find(this->nonEmptyBuckets.topRef()));
+    this->nonEmptyBuckets.pop();
+    this->topBucket = this->nonEmptyBuckets.empty() ? nullptr : &this->buckets[this->nonEmptyBuckets.topRef()];
+}
+
+template <typename T, typename Priority>
+void BucketedHeap<T, Priority>::pop() {
+    if (this->count == 0) {
+        return;
+    }
+
+    this->topBucket->pop_back();
+    this->onRemoved();
+}
+
+template <typename T, typename Priority>
+T BucketedHeap<T, Priority>::extract() {
+    T key = std::move(this->topBucket->back());
+    this->topBucket->pop_back();
+    this->onRemoved();
+    return key;
+}
+
+template <typename T, typename Priority>
+void BucketedHeap<T, Priority>::clear() {
+    while (!this->buckets.empty()) {
+        this->recycle(this->buckets.begin());
+    }
+    this->nonEmptyBuckets.clear();
+    this->topBucket = nullptr;
+    this->count = 0;
+}
+
+template <typename T, typename Priority>
+bool BucketedHeap<T, Priority>::empty() const {
+    return this->count == 0;
+}
+
+template <typename T, typename Priority>
+size_t BucketedHeap<T, Priority>::size() const {
+    return this->count;
+}
+
+template <typename T, typename Priority>
+double BucketedHeap<T, Priority>::bucketWidth() const {
+    return this->width;
+}
+
+#endif //DATASTRUCTUREIMPLEMENTATIONS_BUCKETEDHEAP_HPP
@@ -0,0 +1,287 @@
+#ifndef DATASTRUCTUREIMPLEMENTATIONS_DARYHEAP_HPP
+#define DATASTRUCTUREIMPLEMENTATIONS_DARYHEAP_HPP
+
+#include <bit>
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <ranges>
+#include <utility>
+#include <vector>
+#include "Heap.hpp"
+
+/**
+ * 让下标为 1 的元素落在 Alignment 字节边界上的分配器。
+ * d 叉堆中节点 i 的子节点是 D*i+1 ... D*i+D, 所以只要下标 1 对齐，并且 D * sizeof(T) 是缓存行长度的约数或倍数，
+ * 每一组兄弟节点就都不会跨越缓存行，下沉时挑选最大子节点只需要碰一条（或者整数条）缓存行。
+ */
+template <typename T, size_t Alignment = 64>
+class SiblingAlignedAllocator {
+public:
+    using value_type = T;
+
+    template <typename U>
+    struct rebind {
+        using other = SiblingAlignedAllocator<U, Alignment>;
+    };
+
+    SiblingAlignedAllocator() noexcept = default;
+
+    template <typename U>
+    SiblingAlignedAllocator(const SiblingAlignedAllocator<U, Alignment>&) noexcept { }
+
+    T* allocate(size_t n) {
+        auto raw = static_cast<std::byte*>(::operator new(n * sizeof(T) + leadingPadding, std::align_val_t { Alignment }));
+        return reinterpret_cast<T*>(raw + leadingPadding);
+    }
+
+    void deallocate(T* p, size_t n) noexcept {
+        auto raw = reinterpret_cast<std::byte*>(p) - leadingPadding;
+        ::operator delete(raw, n * sizeof(T) + leadingPadding, std::align_val_t { Alignment });
+    }
+
+    template <typename U>
+    bool operator==(const SiblingAlignedAllocator<U, Alignment>&) const noexcept {
+        return true;
+    }
+
+private:
+    /** 在首元素之前空出来的字节数，使得首元素之后的那个元素正好从 Alignment 边界开始 */
+    static constexpr size_t leadingPadding = sizeof(T) < Alignment ? Alignment - sizeof(T) : 0;
+};
+
+/**
+ * d 叉堆，D 在编译期确定（通常取 2, 4, 8），接口和 Heap<T, Compare> 相同。
+ * 相比二叉堆，d 叉堆的深度只有 log_D(n), 下沉路径上的缓存未命中次数更少，
+ * 代价是每一层要在 D 个兄弟节点中挑出优先级最高的那个，而这 D 个兄弟节点在内存中是连续且按缓存行对齐的。
+ */
+template <typename T, size_t D = 4, typename Compare = std::less<>>
+class DaryHeap {
+    static_assert(D >= 2, "DaryHeap requires a fan-out of at least 2");
+
+public:
+    /** 构造一个空堆，可以指定 key 的排序准则 */
+    explicit DaryHeap(const Compare& compare = Compare());
+
+    /** 通过堆化一个 std::vector<KeyType> 实例建立堆，元素会被移动到按缓存行对齐的存储区域中 */
+    DaryHeap(std::vector<T>&& heapStorageArray, const Compare& compare = Compare());
+
+    /** 不允许复制 */
+    DaryHeap(const DaryHeap& rhs) = delete;
+
+    /** 可移动 */
+    DaryHeap(DaryHeap&& rhs) noexcept = default;
+
+    /** 插入一个元素到堆中 */
+    void insert(const T& key);
+
+    /** 批量插入 range 中的所有元素，策略的含义和 Heap::pushBulk 相同 */
+    template <std::ranges::input_range Range>
+    void pushBulk(Range&& range, BulkInsertStrategy strategy = BulkInsertStrategy::Auto);
+
+    /** 查看堆顶部的元素 */
+    [[nodiscard]] T top() const;
+
+    /** 弹出堆顶部的元素 */
+    void pop();
+
+    /** 清除堆的所有元素 */
+    void clear();
+
+    /** 检查这个堆是否是空堆 */
+    [[nodiscard]] bool empty() const;
+
+    /** 返回队列长度 */
+    [[nodiscard]] size_t size() const;
+
+    /** 更新比较器并且以新的比较器作为排序准则立即进行重新排序 */
+    void updateComparator(const Compare& compare);
+
+private:
+    /** 堆的存储区域，每组兄弟节点从缓存行的边界开始 */
+    std::vector<T, SiblingAlignedAllocator<T>> _store;
+
+    /** 比较器 */
+    [[no_unique_address]] Compare compare;
+
+    /** 让 nodeOffset 指向的节点上浮，直至堆性恢复 */
+    void reHeapifyByFloat(size_t nodeOffset);
+
+    /** 让 nodeOffset 指向的节点下沉，直至堆性恢复 */
+    void reHeapifyBySink(size_t nodeOffset);
+
+    /** 自底向上重建整个堆，O(n) */
+    void fullReHeapify();
+
+    /** 获取一个节点的父节点的下标，调用者须保证 nodeOffset > 0 */
+    static constexpr size_t getParentOffset(size_t nodeOffset) noexcept;
+
+    /** 获取一个节点的第一个子节点的下标，其余的子节点紧随其后 */
+    static constexpr size_t getFirstChildOffset(size_t nodeOffset) noexcept;
+
+    /** 比较两个 key，返回 true 当且仅当 lhs 的优先级低于 rhs */
+    [[nodiscard]] bool comparePriorityLessThan(const T& lhs, const T& rhs) const;
+};
+
+template <typename T, size_t D, typename Compare>
+DaryHeap<T, D, Compare>::DaryHeap(const Compare &_compare) : _store(), compare(_compare) { }
+
+template <typename T, size_t D, typename Compare>
+DaryHeap<T, D, Compare>::DaryHeap(std::vector<T> &&heapStorageArray, const Compare &_compare)
+: _store(std::make_move_iterator(heapStorageArray.begin()), std::make_move_iterator(heapStorageArray.end())), compare(_compare) {
+    heapStorageArray.clear();
+    this->fullReHeapify();
+}
+
+template <typename T, size_t D, typename Compare>
+constexpr size_t DaryHeap<T, D, Compare>::getParentOffset(size_t nodeOffset) noexcept {
+    return (nodeOffset - 1) / D;
+}
+
+template <typename T, size_t D, typename Compare>
+constexpr size_t DaryHeap<T, D, Compare>::getFirstChildOffset(size_t nodeOffset) noexcept {
+    return nodeOffset * D + 1;
+}
+
+template <typename T, size_t D, typename Compare>
+void DaryHeap<T, D, Compare>::insert(const T &key) {
+    this->_store.push_back(key);
+    this->reHeapifyByFloat(this->_store.size() - 1);
+}
+
+template <typename T, size_t D, typename Compare>
+template <std::ranges::input_range Range>
+void DaryHeap<T, D, Compare>::pushBulk(Range &&range, BulkInsertStrategy strategy) {
+    size_t existingCount = this->_store.size();
+    if constexpr (std::ranges::sized_range<Range>) {
+        this->_store.reserve(existingCount + std::ranges::size(range));
+    }
+
+    for (auto &&key : range) {
+        this->_store.emplace_back(std::forward<decltype(key)>(key));
+    }
+
+    size_t batchCount = this->_store.size() - existingCount;
+    if (strategy == BulkInsertStrategy::Auto) {
+        size_t totalCount = existingCount + batchCount;
+        size_t depth = std::bit_width(totalCount) / std::bit_width(D - 1);
+        strategy = batchCount * depth >= totalCount * 4 ? BulkInsertStrategy::Rebuild : BulkInsertStrategy::Incremental;
+    }
+
+    if (strategy == BulkInsertStrategy::Rebuild) {
+        this->fullReHeapify();
+    } else {
+        for (size_t ptr = existingCount; ptr < this->_store.size(); ++ptr) {
+            this->reHeapifyByFloat(ptr);
+        }
+    }
+}
+
+template <typename T, size_t D, typename Compare>
+T DaryHeap<T, D, Compare>::top() const {
+    return this->_store[0];
+}
+
+template <typename T, size_t D, typename Compare>
+void DaryHeap<T, D, Compare>::pop() {
+    if (this->_store.empty()) {
+        return;
+    }
+
+    if (this->_store.size() > 1) {
+        this->_store.front() = std::move(this->_store.back());
+        this->_store.pop_back();
+        this->reHeapifyBySink(0);
+    } else {
+        this->_store.pop_back();
+    }
+}
+
+template <typename T, size_t D, typename Compare>
+void DaryHeap<T, D, Compare>::reHeapifyByFloat(size_t nodeOffset) {
+    T key = std::move(this->_store[nodeOffset]);
+    while (nodeOffset > 0) {
+        size_t parentOffset = getParentOffset(nodeOffset);
+        if (!this->comparePriorityLessThan(this->_store[parentOffset], key)) {
+            break;
+        }
+
+        this->_store[nodeOffset] = std::move(this->_store[parentOffset]);
+        nodeOffset = parentOffset;
+    }
+
+    this->_store[nodeOffset] = std::move(key);
+}
+
+template <typename T, size_t D, typename Compare>
+void DaryHeap<T, D, Compare>::reHeapifyBySink(size_t nodeOffset) {
+    const size_t storeSize = this->_store.size();
+    T key = std::move(this->_store[nodeOffset]);
+    size_t firstChildOffset = getFirstChildOffset(nodeOffset);
+    while (firstChildOffset < storeSize) {
+        // 在这一组（最多 D 个）兄弟节点中挑出优先级最高的那个，满的一组用编译期确定的循环次数，方便编译器展开
+        size_t bestOffset = firstChildOffset;
+        if (firstChildOffset + D <= storeSize) {
+            for (size_t i = 1; i < D; ++i) {
+                if (this->comparePriorityLessThan(this->_store[bestOffset], this->_store[firstChildOffset + i])) {
+                    bestOffset = firstChildOffset + i;
+                }
+            }
+        } else {
+            for (size_t childOffset = firstChildOffset + 1; childOffset < storeSize; ++childOffset) {
+                if (this->comparePriorityLessThan(this->_store[bestOffset], this->_store[childOffset])) {
+                    bestOffset = childOffset;
+                }
+            }
+        }
+
+        if (!this->comparePriorityLessThan(key, this->_store[bestOffset])) {
+            break;
+        }
+
+        this->_store[nodeOffset] = std::move(this->_store[bestOffset]);
+        nodeOffset = bestOffset;
+        firstChildOffset = getFirstChildOffset(nodeOffset);
+    }
+
+    this->_store[nodeOffset] = std::move(key);
+}
+
+template <typename T, size_t D, typename Compare>
+void DaryHeap<T, D, Compare>::fullReHeapify() {
+    if (this->_store.size() < 2) {
+        return;
+    }
+
+    for (size_t ptr = getParentOffset(this->_store.size() - 1) + 1; ptr > 0; --ptr) {
+        this->reHeapifyBySink(ptr - 1);
+    }
+}
+
+template <typename T, size_t D, typename Compare>
+bool DaryHeap<T, D, Compare>::comparePriorityLessThan(const T &lhs, const T &rhs) const {
+    return this->compare(lhs, rhs);
+}
+
+template <typename T, size_t D, typename Compare>
+void DaryHeap<T, D, Compare>::updateComparator(const Compare &_compare) {
+    this->compare = _compare;
+    this->fullReHeapify();
+}
+
+template <typename T, size_t D, typename Compare>
+void DaryHeap<T, D, Compare>::clear() {
+    this->_store.clear();
+}
+
+template <typename T, size_t D, typename Compare>
+bool DaryHeap<T, D, Compare>::empty() const {
+    return this->_store.empty();
+}
+
+template <typename T, size_t D, typename Compare>
+size_t DaryHeap<T, D, Compare>::size() const {
+    return this->_store.size();
+}
+
+#endif //DATASTRUCTUREIMPLEMENTATIONS_DARYHEAP_HPP
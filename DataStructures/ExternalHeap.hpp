@@ -0,0 +1,297 @@
+#ifndef DATASTRUCTUREIMPLEMENTATIONS_EXTERNALHEAP_HPP
+#define DATASTRUCTUREIMPLEMENTATIONS_EXTERNALHEAP_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <cstdio>
+#include <filesystem>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "Heap.hpp"
+
+/** ExternalHeap 的配置 */
+struct ExternalHeapOptions {
+    /** 内存中插入堆的字节预算，插入堆满了就整体写成一个有序的顺串 */
+    size_t memoryBudgetBytes = 64 << 20;
+
+    /** 每个顺串的预读缓冲区（也是写出时的缓冲区）的字节数 */
+    size_t readAheadBytes = 64 << 10;
+
+    /** 顺串临时文件所在的目录 */
+    std::filesystem::path tempDirectory = std::filesystem::temp_directory_path();
+};
+
+/**
+ * 外存优先队列：元素的总量超过内存预算时，把多出来的部分写到临时文件里，Compare 的约定和 Heap 一致。
+ *
+ * 主要思路：
+ * - 新元素先进入内存中的插入堆（一个 Heap<T, Compare>），插入堆达到预算之后，
+ *   按优先级从高到低把它全部写成一个有序的"顺串"（run）临时文件，然后清空；
+ * - 每个顺串只在内存里保留一个预读缓冲区，缓冲区里读完了才从文件中读下一块；
+ * - 另有一个以顺串编号为元素的小堆，按各个顺串的当前头部排序，做 k 路归并；
+ * - top / pop 比较插入堆的堆顶和最好的顺串头部，取其中优先级更高的那个。
+ * 所以常驻内存的是 memoryBudgetBytes 加上每个未读完的顺串各 readAheadBytes.
+ * 插入堆的存储区域在构造时就按预算一次性预留好，不会因为按倍数扩容而在写出之前膨胀到预算的两倍。
+ *
+ * 元素以原始字节的形式写入文件，所以 T 必须是可平凡复制的；临时文件在顺串读完或者堆析构时删除。
+ * 文件读写失败时抛出 std::runtime_error. 写出顺串时失败只提供基本保证：
+ * 堆仍然可用，size() 和剩下的元素一致，但插入堆中已经弹出、写进这个半成品顺串的元素会随着临时文件一起丢失。
+ */
+template <typename T, typename Compare = std::less<>>
+class ExternalHeap {
+    static_assert(std::is_trivially_copyable_v<T>, "ExternalHeap stores raw bytes of T in temporary files");
+
+public:
+    /** 按照 options 构造一个空堆，可以指定 key 的排序准则 */
+    explicit ExternalHeap(const ExternalHeapOptions& options = ExternalHeapOptions(), const Compare& compare = Compare());
+
+    /** 不允许复制 */
+    ExternalHeap(const ExternalHeap& rhs) = delete;
+
+    /** 插入一个元素，插入堆满了会触发一次写出，写出失败时 key 不会被插入（见类的说明） */
+    void insert(const T& key);
+
+    /** 查看堆顶部的元素，堆不得为空 */
+    [[nodiscard]] const T& top() const;
+
+    /** 弹出堆顶部的元素 */
+    void pop();
+
+    /** 检查这个堆是否是空堆 */
+    [[nodiscard]] bool empty() const;
+
+    /** 返回元素的个数，包括已经写到文件中的 */
+    [[nodiscard]] size_t size() const;
+
+    /** 目前还没有读完的顺串个数 */
+    [[nodiscard]] size_t runCount() const;
+
+private:
+    /** 一个顺串：一个按优先级从高到低排好序的临时文件，加上它的预读缓冲区 */
+    struct Run {
+        Run(std::FILE* file, std::filesystem::path path, size_t remainingOnDisk)
+        : file(file), path(std::move(path)), buffer(), cursor(0), remainingOnDisk(remainingOnDisk) { }
+
+        Run(const Run& rhs) = delete;
+
+        ~Run() {
+            std::fclose(this->file);
+            std::error_code ignored;
+            std::filesystem::remove(this->path, ignored);
+        }
+
+        std::FILE* file;
+        std::filesystem::path path;
+
+        /** 预读缓冲区，buffer[cursor] 是这个顺串当前的头部 */
+        std::vector<T> buffer;
+        size_t cursor;
+
+        /** 还留在文件里没有读进缓冲区的元素个数 */
+        size_t remainingOnDisk;
+    };
+
+    /** 比较两个顺串的头部，顺串编号作为 Heap 的元素 */
+    struct RunHeadCompare {
+        const std::vector<std::unique_ptr<Run>>* runs;
+        [[no_unique_address]] Compare compare;
+
+        bool operator()(size_t lhs, size_t rhs) const {
+            const Run &lhsRun = *(*this->runs)[lhs];
+            const Run &rhsRun = *(*this->runs)[rhs];
+            return this->compare(lhsRun.buffer[lhsRun.cursor], rhsRun.buffer[rhsRun.cursor]);
+        }
+    };
+
+    ExternalHeapOptions options;
+
+    /** 插入堆最多容纳的元素个数 */
+    size_t insertionCapacity;
+
+    /** 每次读写的元素个数 */
+    size_t blockElements;
+
+    Heap<T, Compare> insertionHeap;
+
+    /** 顺串，读完的顺串被释放后留下空指针，全部读完时整体清空 */
+    std::vector<std::unique_ptr<Run>> runs;
+
+    /** 按头部排序的顺串编号 */
+    Heap<size_t, RunHeadCompare> runHeads;
+
+    /** 所有顺串中还没有被弹出的元素个数 */
+    size_t spilledCount;
+
+    /** 写出顺串时复用的缓冲区 */
+    std::vector<T> writeBuffer;
+
+    /** 临时文件名的前缀，每个实例不同，避免和其他实例或进程冲突 */
+    std::string filePrefix;
+    size_t nextRunId;
+
+    [[no_unique_address]] Compare compare;
+
+    /** 把插入堆的全部元素按优先级从高到低写成一个新的顺串 */
+    void spill();
+
+    /** 一个预留了 capacity 个元素的空数组，用作插入堆的存储区域 */
+    [[nodiscard]] static std::vector<T> reservedStorage(size_t capacity);
+
+    /** 从文件中读下一块到顺串的缓冲区 */
+    void refill(Run& run);
+
+    /** 最好的顺串头部是否比插入堆的堆顶更应该先出来 */
+    [[nodiscard]] bool runHeadsGoFirst() const;
+};
+
+template <typename T, typename Compare>
+ExternalHeap<T, Compare>::ExternalHeap(const ExternalHeapOptions &_options, const Compare &_compare)
+: options(_options),
+  insertionCapacity(std::max<size_t>(1, _options.memoryBudgetBytes / sizeof(T))),
+  blockElements(std::max<size_t>(1, _options.readAheadBytes / sizeof(T))),
+  insertionHeap(reservedStorage(this->insertionCapacity), _compare),
+  runs(),
+  runHeads(RunHeadCompare { &this->runs, _compare }),
+  spilledCount(0),
+  writeBuffer(),
+  filePrefix(),
+  nextRunId(0),
+  compare(_compare) {
+    std::random_device randomDevice;
+    this->filePrefix = "external-heap-" + std::to_string(randomDevice()) + std::to_string(randomDevice()) + "-";
+}
+
+template <typename T, typename Compare>
+std::vector<T> ExternalHeap<T, Compare>::reservedStorage(size_t capacity) {
+    std::vector<T> storage;
+    storage.reserve(capacity);
+    return storage;
+}
+
+template <typename T, typename Compare>
+void ExternalHeap<T, Compare>::insert(const T &key) {
+    if (this->insertionHeap.size() >= this->insertionCapacity) {
+        this->spill();
+    }
+
+    this->insertionHeap.insert(key);
+}
+
+template <typename T, typename Compare>
+void ExternalHeap<T, Compare>::spill() {
+    std::filesystem::path path = this->options.tempDirectory / (this->filePrefix + std::to_string(this->nextRunId++) + ".run");
+    std::FILE* file = std::fopen(path.string().c_str(), "w+b");
+    if (!file) {
+        throw std::runtime_error("ExternalHeap: cannot create run file " + path.string());
+    }
+
+    size_t runLength = this->insertionHeap.size();
+    auto run = std::make_unique<Run>(file, std::move(path), runLength);
+
+    // 分块弹出再写出，写出缓冲区只占 readAheadBytes, 不需要把整个插入堆复制一份；
+    // popK 只在存储区域内部挪动元素，构造时预留的容量一直保留着，下一轮插入不会重新扩容
+    this->writeBuffer.reserve(this->blockElements);
+    while (!this->insertionHeap.empty()) {
+        this->writeBuffer.clear();
+        this->insertionHeap.popK(this->blockElements, std::back_inserter(this->writeBuffer));
+        if (std::fwrite(this->writeBuffer.data(), sizeof(T), this->writeBuffer.size(), file) != this->writeBuffer.size()) {
+            throw std::runtime_error("ExternalHeap: cannot write run file " + run->path.string());
+        }
+    }
+
+    if (std::fflush(file) != 0 || std::fseek(file, 0, SEEK_SET) != 0) {
+        throw std::runtime_error("ExternalHeap: cannot rewind run file " + run->path.string());
+    }
+
+    this->refill(*run);
+    this->spilledCount += runLength;
+    this->runs.push_back(std::move(run));
+    this->runHeads.insert(this->runs.size() - 1);
+}
+
+template <typename T, typename Compare>
+void ExternalHeap<T, Compare>::refill(Run &run) {
+    size_t count = std::min(this->blockElements, run.remainingOnDisk);
+    run.buffer.resize(count);
+    run.cursor = 0;
+    if (std::fread(run.buffer.data(), sizeof(T), count, run.file) != count) {
+        throw std::runtime_error("ExternalHeap: cannot read run file " + run.path.string());
+    }
+    run.remainingOnDisk -= count;
+}
+
+template <typename T, typename Compare>
+bool ExternalHeap<T, Compare>::runHeadsGoFirst() const {
+    if (this->runHeads.empty()) {
+        return false;
+    }
+
+    if (this->insertionHeap.empty()) {
+        return true;
+    }
+
+    const Run &best = *this->runs[this->runHeads.topRef()];
+    return this->compare(this->insertionHeap.topRef(), best.buffer[best.cursor]);
+}
+
+template <typename T, typename Compare>
+const T &ExternalHeap<T, Compare>::top() const {
+    assert((!this->empty()));
+    if (this->runHeadsGoFirst()) {
+        const Run &best = *this->runs[this->runHeads.topRef()];
+        return best.buffer[best.cursor];
+    }
+
+    return this->insertionHeap.topRef();
+}
+
+template <typename T, typename Compare>
+void ExternalHeap<T, Compare>::pop() {
+    if (!this->runHeadsGoFirst()) {
+        this->insertionHeap.pop();
+        return;
+    }
+
+    size_t runIdx = this->runHeads.topRef();
+    Run &run = *this->runs[runIdx];
+    --this->spilledCount;
+    if (++run.cursor == run.buffer.size()) {
+        if (run.remainingOnDisk == 0) {
+            // 顺串读完了：关闭并删除文件，全部读完时顺便回收编号
+            this->runHeads.pop();
+            this->runs[runIdx].reset();
+            if (this->runHeads.empty()) {
+                this->runs.clear();
+            }
+            return;
+        }
+
+        this->refill(run);
+    }
+
+    // 头部变差了，让它在 runHeads 中下沉
+    this->runHeads.replaceTop(runIdx);
+}
+
+template <typename T, typename Compare>
+bool ExternalHeap<T, Compare>::empty() const {
+    return this->insertionHeap.empty() && this->runHeads.empty();
+}
+
+template <typename T, typename Compare>
+size_t ExternalHeap<T, Compare>::size() const {
+    return this->insertionHeap.size() + this->spilledCount;
+}
+
+template <typename T, typename Compare>
+size_t ExternalHeap<T, Compare>::runCount() const {
+    return this->runHeads.size();
+}
+
+#endif //DATASTRUCTUREIMPLEMENTATIONS_EXTERNALHEAP_HPP
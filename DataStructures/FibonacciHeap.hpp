@@ -0,0 +1,444 @@
+#ifndef DATASTRUCTUREIMPLEMENTATIONS_FIBONACCIHEAP_HPP
+#define DATASTRUCTUREIMPLEMENTATIONS_FIBONACCIHEAP_HPP
+
+#include <cassert>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "NodePool.hpp"
+
+/**
+ * 斐波那契堆：一组堆序树组成的根链表，外加一个指向优先级最高的根的指针。
+ * - insert / meld / top: O(1)
+ * - increaseKey: 均摊 O(1), 违反堆序时把节点剪到根链表上，并对做过标记的祖先做级联剪切
+ * - pop / decreaseKey / erase: 均摊 O(log n), pop 时按度数合并根链表上的树
+ *
+ * Compare 以及 increaseKey / decreaseKey 的约定和 AddressableHeap 相同。
+ * 节点从 NodePool 中分配，meld 时连同对方的节点池一起接管，不需要逐个复制节点。
+ */
+template <typename T, typename Compare = std::less<>>
+class FibonacciHeap {
+    struct Node;
+
+public:
+    /** 元素的句柄，在元素被 pop 或者 erase 之前一直有效，meld 之后仍然有效 */
+    using Handle = Node*;
+
+    /** 构造一个空堆，可以指定 key 的排序准则 */
+    explicit FibonacciHeap(const Compare& compare = Compare());
+
+    /** 不允许复制 */
+    FibonacciHeap(const FibonacciHeap& rhs) = delete;
+
+    /** 可移动 */
+    FibonacciHeap(FibonacciHeap&& rhs) noexcept;
+
+    ~FibonacciHeap();
+
+    /** 插入一个元素，返回它的句柄 */
+    Handle insert(const T& key);
+
+    /** 查看堆顶部的元素 */
+    [[nodiscard]] T top() const;
+
+    /** 弹出堆顶部的元素 */
+    void pop();
+
+    /** 把 rhs 的全部元素并入本堆，O(1), 之后 rhs 变为空堆，rhs 上的句柄转而属于本堆 */
+    void meld(FibonacciHeap&& rhs);
+
+    /** 查看句柄对应的元素 */
+    [[nodiscard]] const T& get(Handle handle) const;
+
+    /** 把句柄对应的元素替换为一个优先级不低于它的新 key */
+    void increaseKey(Handle handle, const T& key);
+
+    /** 把句柄对应的元素替换为一个优先级不高于它的新 key */
+    void decreaseKey(Handle handle, const T& key);
+
+    /** 把句柄对应的元素替换为任意的新 key */
+    void update(Handle handle, const T& key);
+
+    /** 删除句柄对应的元素 */
+    void erase(Handle handle);
+
+    /** 清除堆的所有元素 */
+    void clear();
+
+    /** 检查这个堆是否是空堆 */
+    [[nodiscard]] bool empty() const;
+
+    /** 返回队列长度 */
+    [[nodiscard]] size_t size() const;
+
+private:
+    /** 节点：兄弟节点之间是双向循环链表，child 指向任意一个子节点 */
+    struct Node {
+        explicit Node(const T& key)
+        : key(key), parent(nullptr), child(nullptr), left(this), right(this), degree(0), marked(false) { }
+
+        T key;
+        Node* parent;
+        Node* child;
+        Node* left;
+        Node* right;
+        size_t degree;
+        bool marked;
+    };
+
+    /** 优先级最高的根，同时也是根链表的入口 */
+    Node* best;
+    size_t count;
+    NodePool<Node> pool;
+    [[no_unique_address]] Compare compare;
+
+    /** 合并根链表时按度数索引的暂存区，复用以避免每次 pop 都申请内存 */
+    std::vector<Node*> degreeTable;
+
+    /** 合并根链表时收集根节点的暂存区 */
+    std::vector<Node*> rootBuffer;
+
+    /** 把 node 插入到 anchor 所在的循环链表中，放在 anchor 的左边 */
+    static void spliceBefore(Node* anchor, Node* node);
+
+    /** 把 node 从它所在的循环链表中摘下来，使之自成一个环 */
+    static void unlink(Node* node);
+
+    /** 把 node 放到根链表上，必要时更新 best */
+    void addRoot(Node* node);
+
+    /** 把 node 从父节点下剪到根链表上，然后对父节点做级联剪切 */
+    void cutAndCascade(Node* node);
+
+    /** 把 node 的所有子节点移到根链表上 */
+    void promoteChildren(Node* node);
+
+    /** 把根链表上 anyRoot 所在的环按度数合并，并重新找出 best */
+    void consolidate(Node* anyRoot);
+
+    /** 把 node 从堆中摘下来（不回收），它的子节点移到根链表上 */
+    void detach(Node* node);
+
+    /** 析构 anyNode 所在的整个环以及它们的全部后代 */
+    void destroyRing(Node* anyNode);
+
+    /** 比较两个 key，返回 true 当且仅当 lhs 的优先级低于 rhs */
+    [[nodiscard]] bool comparePriorityLessThan(const T& lhs, const T& rhs) const;
+};
+
+template <typename T, typename Compare>
+FibonacciHeap<T, Compare>::FibonacciHeap(const Compare &_compare)
+: best(nullptr), count(0), pool(), compare(_compare), degreeTable(), rootBuffer() { }
+
+template <typename T, typename Compare>
+FibonacciHeap<T, Compare>::FibonacciHeap(FibonacciHeap &&rhs) noexcept
+: best(std::exchange(rhs.best, nullptr)),
+  count(std::exchange(rhs.count, 0)),
+  pool(std::move(rhs.pool)),
+  compare(std::move(rhs.compare)),
+  degreeTable(),
+  rootBuffer() { }
+
+template <typename T, typename Compare>
+FibonacciHeap<T, Compare>::~FibonacciHeap() {
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+        this->destroyRing(this->best);
+    }
+}
+
+template <typename T, typename Compare>
+void FibonacciHeap<T, Compare>::spliceBefore(Node *anchor, Node *node) {
+    node->right = anchor;
+    node->left = anchor->left;
+    anchor->left->right = node;
+    anchor->left = node;
+}
+
+template <typename T, typename Compare>
+void FibonacciHeap<T, Compare>::unlink(Node *node) {
+    node->left->right = node->right;
+    node->right->left = node->left;
+    node->left = node;
+    node->right = node;
+}
+
+template <typename T, typename Compare>
+void FibonacciHeap<T, Compare>::addRoot(Node *node) {
+    node->parent = nullptr;
+    node->marked = false;
+    if (!this->best) {
+        node->left = node;
+        node->right = node;
+        this->best = node;
+        return;
+    }
+
+    spliceBefore(this->best, node);
+    if (this->comparePriorityLessThan(this->best->key, node->key)) {
+        this->best = node;
+    }
+}
+
+template <typename T, typename Compare>
+typename FibonacciHeap<T, Compare>::Handle FibonacciHeap<T, Compare>::insert(const T &key) {
+    Node* node = this->pool.create(key);
+    this->addRoot(node);
+    ++this->count;
+    return node;
+}
+
+template <typename T, typename Compare>
+T FibonacciHeap<T, Compare>::top() const {
+    return this->best->key;
+}
+
+template <typename T, typename Compare>
+void FibonacciHeap<T, Compare>::pop() {
+    if (!this->best) {
+        return;
+    }
+
+    Node* oldBest = this->best;
+    this->detach(oldBest);
+    this->pool.destroy(oldBest);
+    --this->count;
+}
+
+template <typename T, typename Compare>
+void FibonacciHeap<T, Compare>::meld(FibonacciHeap &&rhs) {
+    if (this == &rhs) {
+        return;
+    }
+
+    if (rhs.best) {
+        if (!this->best) {
+            this->best = rhs.best;
+        } else {
+            // 把两个环剪开再接成一个环
+            Node* lhsLast = this->best->left;
+            Node* rhsLast = rhs.best->left;
+            lhsLast->right = rhs.best;
+            rhs.best->left = lhsLast;
+            rhsLast->right = this->best;
+            this->best->left = rhsLast;
+            if (this->comparePriorityLessThan(this->best->key, rhs.best->key)) {
+                this->best = rhs.best;
+            }
+        }
+    }
+
+    this->count += rhs.count;
+    this->pool.adopt(std::move(rhs.pool));
+    rhs.best = nullptr;
+    rhs.count = 0;
+}
+
+template <typename T, typename Compare>
+const T &FibonacciHeap<T, Compare>::get(Handle handle) const {
+    return handle->key;
+}
+
+template <typename T, typename Compare>
+void FibonacciHeap<T, Compare>::increaseKey(Handle handle, const T &key) {
+    assert((!this->comparePriorityLessThan(key, handle->key)));
+    handle->key = key;
+    Node* parent = handle->parent;
+    if (parent && this->comparePriorityLessThan(parent->key, handle->key)) {
+        this->cutAndCascade(handle);
+    }
+
+    if (this->comparePriorityLessThan(this->best->key, handle->key)) {
+        this->best = handle;
+    }
+}
+
+template <typename T, typename Compare>
+void FibonacciHeap<T, Compare>::decreaseKey(Handle handle, const T &key) {
+    assert((!this->comparePriorityLessThan(handle->key, key)));
+    this->detach(handle);
+    handle->key = key;
+    handle->child = nullptr;
+    handle->degree = 0;
+    this->addRoot(handle);
+}
+
+template <typename T, typename Compare>
+void FibonacciHeap<T, Compare>::update(Handle handle, const T &key) {
+    if (this->comparePriorityLessThan(key, handle->key)) {
+        this->decreaseKey(handle, key);
+    } else {
+        this->increaseKey(handle, key);
+    }
+}
+
+template <typename T, typename Compare>
+void FibonacciHeap<T, Compare>::erase(Handle handle) {
+    this->detach(handle);
+    this->pool.destroy(handle);
+    --this->count;
+}
+
+template <typename T, typename Compare>
+void FibonacciHeap<T, Compare>::detach(Node *node) {
+    if (node->parent) {
+        this->cutAndCascade(node);
+    }
+
+    this->promoteChildren(node);
+
+    if (node->right == node) {
+        // 根链表上只剩它自己
+        this->best = nullptr;
+        return;
+    }
+
+    Node* anyRoot = node->right;
+    unlink(node);
+    if (node == this->best) {
+        this->consolidate(anyRoot);
+    }
+}
+
+template <typename T, typename Compare>
+void FibonacciHeap<T, Compare>::promoteChildren(Node *node) {
+    Node* child = node->child;
+    if (!child) {
+        return;
+    }
+
+    do {
+        child->parent = nullptr;
+        child->marked = false;
+        child = child->right;
+    } while (child != node->child);
+
+    // 把整个子节点环接到 node 的右边，node 此时一定在根链表上
+    Node* childLast = child->left;
+    Node* nodeNext = node->right;
+    node->right = child;
+    child->left = node;
+    childLast->right = nodeNext;
+    nodeNext->left = childLast;
+
+    node->child = nullptr;
+    node->degree = 0;
+}
+
+template <typename T, typename Compare>
+void FibonacciHeap<T, Compare>::cutAndCascade(Node *node) {
+    while (Node* parent = node->parent) {
+        if (parent->child == node) {
+            parent->child = node->right == node ? nullptr : node->right;
+        }
+        unlink(node);
+        --parent->degree;
+        this->addRoot(node);
+
+        if (!parent->parent) {
+            break;
+        }
+
+        if (!parent->marked) {
+            parent->marked = true;
+            break;
+        }
+
+        node = parent;
+    }
+}
+
+template <typename T, typename Compare>
+void FibonacciHeap<T, Compare>::consolidate(Node *anyRoot) {
+    auto &table = this->degreeTable;
+    table.clear();
+
+    // 先把环上的根收集起来，合并的过程中会不断地改写链表
+    auto &roots = this->rootBuffer;
+    roots.clear();
+    Node* head = anyRoot;
+    do {
+        roots.push_back(head);
+        head = head->right;
+    } while (head != anyRoot);
+
+    for (Node* node : roots) {
+        unlink(node);
+        size_t degree = node->degree;
+        while (degree < table.size() && table[degree]) {
+            Node* other = std::exchange(table[degree], nullptr);
+            if (this->comparePriorityLessThan(node->key, other->key)) {
+                std::swap(node, other);
+            }
+
+            // other 成为 node 的子节点
+            other->parent = node;
+            other->marked = false;
+            if (node->child) {
+                spliceBefore(node->child, other);
+            } else {
+                node->child = other;
+            }
+            ++node->degree;
+            ++degree;
+        }
+
+        if (degree >= table.size()) {
+            table.resize(degree + 1, nullptr);
+        }
+        table[degree] = node;
+    }
+
+    this->best = nullptr;
+    for (Node* node : table) {
+        if (node) {
+            this->addRoot(node);
+        }
+    }
+}
+
+template <typename T, typename Compare>
+void FibonacciHeap<T, Compare>::destroyRing(Node *anyNode) {
+    if (!anyNode) {
+        return;
+    }
+
+    std::vector<Node*> stack { anyNode };
+    while (!stack.empty()) {
+        Node* ringEntry = stack.back();
+        stack.pop_back();
+        Node* node = ringEntry;
+        do {
+            Node* next = node->right;
+            if (node->child) {
+                stack.push_back(node->child);
+            }
+            this->pool.destroy(node);
+            node = next;
+        } while (node != ringEntry);
+    }
+}
+
+template <typename T, typename Compare>
+bool FibonacciHeap<T, Compare>::comparePriorityLessThan(const T &lhs, const T &rhs) const {
+    return this->compare(lhs, rhs);
+}
+
+template <typename T, typename Compare>
+void FibonacciHeap<T, Compare>::clear() {
+    this->destroyRing(this->best);
+    this->best = nullptr;
+    this->count = 0;
+}
+
+template <typename T, typename Compare>
+bool FibonacciHeap<T, Compare>::empty() const {
+    return this->best == nullptr;
+}
+
+template <typename T, typename Compare>
+size_t FibonacciHeap<T, Compare>::size() const {
+    return this->count;
+}
+
+#endif //DATASTRUCTUREIMPLEMENTATIONS_FIBONACCIHEAP_HPP
@@ -7,10 +7,16 @@
 
 #include <iostream>
 #include <concepts>
-#include <memory>
 #include <string>
 #include <vector>
 #include <functional>
+#include <utility>
+#include <type_traits>
+#include <ranges>
+#include <bit>
+#include <algorithm>
+#include <cassert>
+#include "HeapStats.hpp"
 
 template <typename T>
 void printVector(const std::vector<T>& v) {
@@ -28,33 +34,108 @@ void printVector(const std::vector<T>& v) {
     std::cout << "\n";
 }
 
+/** 运行时比较器，返回 true 当且仅当 a >= b，即 a 应当排在 b 的上面 */
 template <typename T>
 using Comparator = std::function<bool (const T& a, const T& b)>;
 
+/**
+ * 把运行时比较器 Comparator<T> 适配成 Heap 所需的 Compare 策略。
+ * Comparator<T> 表达的是 a >= b, 而 Compare 策略表达的是 a < b, 所以这里取反。
+ * 每次比较都要经过 std::function 的间接调用，只在排序准则必须在运行时决定时才用它。
+ */
 template <typename T>
+class RuntimeComparator {
+public:
+    template <typename F>
+    requires (!std::same_as<std::remove_cvref_t<F>, RuntimeComparator<T>>) && std::convertible_to<F, Comparator<T>>
+    RuntimeComparator(F&& greaterThanOrEqual) : greaterThanOrEqual(std::forward<F>(greaterThanOrEqual)) { }
+
+    bool operator()(const T& a, const T& b) const {
+        return !this->greaterThanOrEqual(a, b);
+    }
+
+private:
+    Comparator<T> greaterThanOrEqual;
+};
+
+/** 批量插入的策略：逐个上浮，还是追加之后整体重建，Auto 表示按批量大小自动选择 */
+enum class BulkInsertStrategy { Auto, Incremental, Rebuild };
+
+/**
+ * 堆，Compare 是排序准则，约定和 std::priority_queue 一致：
+ * compare(a, b) 为 true 表示 a 的优先级低于 b, 堆顶永远是优先级最高的元素，
+ * 所以默认的 std::less<> 得到的是大顶堆，传入 std::greater<> 则得到小顶堆。
+ * Compare 是一个编译期就确定的类型，比较操作可以被内联。
+ * Stats 是统计策略（见 HeapStats.hpp），默认的 NoHeapStats 不产生任何开销，
+ * 换成 CountingHeapStats 可以统计比较、移动和上浮下沉的层数，换成 ValidatingHeapStats 则每次修改后都检查堆性。
+ */
+template <typename T, typename Compare = std::less<>, typename Stats = NoHeapStats>
 class Heap {
 public:
-    /** 构造一个空堆，必须指定 key 的排序准则 */
-    explicit Heap(const Comparator<T>& comparator);
+    /** 构造一个空堆，可以指定 key 的排序准则 */
+    explicit Heap(const Compare& compare = Compare());
 
     /** 通过堆化一个 std::vector<KeyType> 实例建立堆，并且使用传入的自定义比较器对各个 key 进行比较 */
-    Heap(std::vector<T>&& heapStorageArray, const Comparator<T>& comparator);
+    Heap(std::vector<T>&& heapStorageArray, const Compare& compare = Compare());
 
     /** 不允许复制 */
-    Heap(const Heap<T>& rhs) = delete;
+    Heap(const Heap& rhs) = delete;
 
     /** 声明了堆的移动语义，从而一个实现了移动语义的堆是可移的 */
-    Heap(Heap<T>&& rhs) noexcept;
+    Heap(Heap&& rhs) noexcept;
 
     /** 插入一个元素到堆中，并保证在元素被插入到堆的存储区域中之后此实例的堆性仍然得到维持 */
     void insert(const T& key);
 
+    /** 以移动的方式插入一个元素，只能移动的类型（比如 std::unique_ptr）也可以放进堆里 */
+    void insert(T&& key);
+
+    /** 用 args 在存储区域的末尾直接构造一个元素，然后让它上浮 */
+    template <typename... Args>
+    void emplace(Args&&... args);
+
+    /**
+     * 批量插入 range 中的所有元素。
+     * 元素先被全部追加到存储区域的末尾，然后要么逐个上浮（每个 O(log n)），
+     * 要么对整个存储区域做一次 O(n) 的自底向上重建，Auto 策略会根据批量的大小选择其中代价更小的一种。
+     */
+    template <std::ranges::input_range Range>
+    void pushBulk(Range&& range, BulkInsertStrategy strategy = BulkInsertStrategy::Auto);
+
     /** 查看堆顶部的元素 */
     T top() const;
 
+    /** 查看堆顶部的元素，返回常量引用而不是副本，引用在堆下一次被修改之前有效 */
+    const T& topRef() const;
+
+    /**
+     * 按优先级从高到低查看前 k 个元素，不修改堆。
+     * 借助一个以下标为元素的小辅助堆，从根开始按需展开子节点，代价是 O(k log k), 与堆的大小无关。
+     * 返回的引用在堆下一次被修改之前有效。
+     */
+    [[nodiscard]] std::vector<std::reference_wrapper<const T>> peekK(size_t k) const;
+
     /** 弹出堆顶部堆元素，并且在弹出后立即着手进行堆性的恢复操作 */
     void pop();
 
+    /** 弹出堆顶部的元素并把它移动出来返回，堆不得为空 */
+    T extract();
+
+    /** 用 key 替换堆顶部的元素并让它下沉，相当于 pop 之后再 insert, 但只做一次下沉，堆不得为空 */
+    void replaceTop(const T& key);
+
+    /** 以移动的方式替换堆顶部的元素 */
+    void replaceTop(T&& key);
+
+    /**
+     * 按优先级从高到低弹出前 k 个元素（不足 k 个则全部弹出），依次移动到 out 中，返回写完之后的 out.
+     * 被弹出的元素在存储区域中占据的位置构成一棵包含根的子树，
+     * 先用末尾的元素填补这些空洞，再按下标从大到小对填补过的位置做一次下沉，一次性恢复堆性，
+     * 而不是做 k 次完整的 pop.
+     */
+    template <typename OutputIt>
+    OutputIt popK(size_t k, OutputIt out);
+
     /** 清除堆的所有元素 */
     void clear();
 
@@ -65,182 +146,323 @@ public:
     [[nodiscard]] size_t size() const;
 
     /** 更新比较器并且以新的比较器作为排序准则立即进行重新排序 */
-    void updateComparator(const Comparator<T>& comparator);
+    void updateComparator(const Compare& compare);
+
+    /**
+     * 对堆的存储区域进行完整的检查，检查堆性是否满足，O(n).
+     * Stats::validatesAfterMutation 为 true 时每次修改之后都会自动调用它，它自己的比较不计入统计。
+     */
+    [[nodiscard]] bool isHeapPropertySatisfied() const;
+
+    /** 统计策略的实例，只有在使用 CountingHeapStats 这类策略时才有内容 */
+    [[nodiscard]] const Stats& stats() const;
+
+    /** 统计策略的实例，可以用来清零计数 */
+    Stats& stats();
 private:
     /** 堆的存储区域，或者说是堆的 Array 形式 */
     std::vector<T> _store;
 
-    /** 对堆的存储区域进行完整的检查，旨在检查堆性是否满足（只有调试的时候有用） */
-    [[nodiscard]] bool isHeapPropertySatisfied();
+    /** 比较器，可被修改，无状态的比较器不占空间 */
+    [[no_unique_address]] Compare compare;
+
+    /** 统计策略，const 的查询操作中也要计数，所以是 mutable 的；NoHeapStats 不占空间 */
+    [[no_unique_address]] mutable Stats statistics;
+
+    /** 每次修改之后调用：记录规模，按需检查堆性 */
+    void afterMutation();
 
-    /** 尝试让 nodeOffset 指向的节点上浮，直至堆性恢复 */
+    /** 按优先级从高到低找出前 k 个元素在存储区域中的下标，k 不得超过元素个数 */
+    [[nodiscard]] std::vector<size_t> findTopOffsets(size_t k) const;
+
+    /**
+     * 让 nodeOffset 指向的节点上浮，直至堆性恢复。
+     * 上浮的过程中不做交换：先把该节点的 key 移出来，留下一个"空洞"，
+     * 沿途比它小的父节点依次下移填补空洞，最后把 key 放进空洞最终停留的位置，
+     * 这样每一层只需要一次移动，而不是 swap 的三次复制。
+     */
     void reHeapifyByFloat(size_t nodeOffset);
 
-    /** 尝试让 nodeOffset 指向的节点下沉，直至堆性恢复 */
+    /** 让 nodeOffset 指向的节点下沉，直至堆性恢复，同样采用空洞式的移动 */
     void reHeapifyBySink(size_t nodeOffset);
 
-    /** 对堆的整个存储区域重新做一次完整的堆化操作，通常是需要在更改比较器之后立刻进行 */
+    /** 根部的元素已经被移走（或者不再需要）时，把最后一个元素挪到根部并让它下沉 */
+    void removeRoot();
+
+    /**
+     * 对堆的整个存储区域重新做一次完整的堆化操作，通常是需要在更改比较器之后立刻进行。
+     * 采用 Floyd 的自底向上建堆：从最后一个非叶子节点开始往前依次下沉，总代价是 O(n).
+     */
     void fullReHeapify();
 
-    /** 尝试获取一个节点的父节点，如果该节点的父节点不存在，则返回一个空指针 */
-    std::unique_ptr<size_t> getParentOffset(size_t nodeOffset);
+    /** 已有 existingCount 个元素的堆再追加 batchCount 个元素时，整体重建是否比逐个上浮更划算 */
+    [[nodiscard]] static bool shouldRebuildForBatch(size_t existingCount, size_t batchCount) noexcept;
 
-    /** 尝试获取一个节点的左子节点，如果该节点的左子节点不存在，则返回一个空指针 */
-    std::unique_ptr<size_t> getLeftChildOffset(size_t nodeOffset);
+    /** 获取一个节点的父节点的下标，调用者须保证 nodeOffset > 0 */
+    static constexpr size_t getParentOffset(size_t nodeOffset) noexcept;
 
-    /** 尝试获取一个节点的右子节点，如果该节点的右子节点不存在，则返回一个空指针 */
-    std::unique_ptr<size_t> getRightChildOffset(size_t nodeOffset);
+    /** 获取一个节点的左子节点的下标，调用者须自行检查该下标是否越界，右子节点的下标就是它加 1 */
+    static constexpr size_t getLeftChildOffset(size_t nodeOffset) noexcept;
 
-    /** 交换两个节点的 key */
-    void swap(size_t lhsOffset, size_t rhsOffset);
+    /** 比较两个 key，返回 true 当且仅当 lhs 的优先级低于 rhs */
+    [[nodiscard]] bool comparePriorityLessThan(const T& lhs, const T& rhs) const;
+};
 
-    /** 以 nodeOffset 指向的节点作为根，判断指定子堆的堆性是否被满足 */
-    [[nodiscard]] bool _isHeapPropertySatisfied(size_t nodeOffset);
+/** 使用运行时比较器的堆，排序准则可以在运行时随意替换 */
+template <typename T>
+using RuntimeHeap = Heap<T, RuntimeComparator<T>>;
 
-    /** 如果 nodeOffset 指向的节点大于等于它的所有子节点，则返回一个空指针，否则返回一个非空指针指向一个 size_t 对象 */
-    std::unique_ptr<size_t> _findHeapPropertyViolation(size_t nodeOffset);
 
-    /** 比较器，可被修改 */
-    Comparator<T> comparator { [](const T& a, const T& b) { return true; } } ;
+template <typename T, typename Compare, typename Stats>
+Heap<T, Compare, Stats>::Heap(const Compare& _compare)
+: _store(std::vector<T> {}), compare(_compare), statistics() { }
 
-    /** 比较两个 node 的类型，返回 true 当前仅当表达式 lhs >= rhs 的求值结果为 true 或者可被隐式转化为 true */
-    [[nodiscard]] bool compareGreaterThanOrEqual(size_t lhsNodeOffset, size_t rhsNodeOffset) const;
-};
+template <typename T, typename Compare, typename Stats>
+void Heap<T, Compare, Stats>::insert(const T &key) {
+    this->_store.push_back(key);
+    this->reHeapifyByFloat(this->_store.size() - 1);
+    this->afterMutation();
+}
 
+template <typename T, typename Compare, typename Stats>
+void Heap<T, Compare, Stats>::insert(T &&key) {
+    this->_store.push_back(std::move(key));
+    this->reHeapifyByFloat(this->_store.size() - 1);
+    this->afterMutation();
+}
 
-template <typename T>
-Heap<T>::Heap(const Comparator<T>& _comparator)
-: comparator(_comparator), _store(std::vector<T> {}) { }
+template <typename T, typename Compare, typename Stats>
+template <typename... Args>
+void Heap<T, Compare, Stats>::emplace(Args &&...args) {
+    this->_store.emplace_back(std::forward<Args>(args)...);
+    this->reHeapifyByFloat(this->_store.size() - 1);
+    this->afterMutation();
+}
 
-template <typename T>
-void Heap<T>::insert(const T &key) {
-    this->_store.push_back(key);
-    this->reHeapifyByFloat(0, this->_store.size());
+template <typename T, typename Compare, typename Stats>
+constexpr size_t Heap<T, Compare, Stats>::getParentOffset(size_t nodeOffset) noexcept {
+    return (nodeOffset - 1) / 2;
 }
 
-template <typename T>
-void Heap<T>::reHeapifyByFloat(size_t nodeOffset) {
-    if (auto parentPtr = this->getParentOffset(nodeOffset)) {
-        if (this->_findHeapPropertyViolation(*parentPtr)) {
-            this->swap(*parentPtr, nodeOffset);
-            this->reHeapifyByFloat(*parentPtr);
+template <typename T, typename Compare, typename Stats>
+constexpr size_t Heap<T, Compare, Stats>::getLeftChildOffset(size_t nodeOffset) noexcept {
+    return nodeOffset * 2 + 1;
+}
+
+template <typename T, typename Compare, typename Stats>
+void Heap<T, Compare, Stats>::reHeapifyByFloat(size_t nodeOffset) {
+    T key = std::move(this->_store[nodeOffset]);
+    size_t depth = 0;
+    while (nodeOffset > 0) {
+        size_t parentOffset = getParentOffset(nodeOffset);
+        if (!this->comparePriorityLessThan(this->_store[parentOffset], key)) {
+            break;
         }
+
+        this->_store[nodeOffset] = std::move(this->_store[parentOffset]);
+        nodeOffset = parentOffset;
+        ++depth;
     }
+
+    this->_store[nodeOffset] = std::move(key);
+    this->statistics.onMove(depth + 2);
+    this->statistics.onSiftUp(depth);
 }
 
-template <typename T>
-std::unique_ptr<size_t> Heap<T>::getLeftChildOffset(size_t nodeOffset) {
-    auto childOffset = nodeOffset * 2 + 1;
-    if (childOffset < this->_store.size() && childOffset >= 0) {
-        return std::make_unique<size_t>(childOffset);
+template <typename T, typename Compare, typename Stats>
+void Heap<T, Compare, Stats>::reHeapifyBySink(size_t nodeOffset) {
+    const size_t storeSize = this->_store.size();
+    T key = std::move(this->_store[nodeOffset]);
+    size_t childOffset = getLeftChildOffset(nodeOffset);
+    size_t depth = 0;
+    while (childOffset < storeSize) {
+        // 挑出两个子节点中优先级较高的那个
+        size_t rightOffset = childOffset + 1;
+        if (rightOffset < storeSize && this->comparePriorityLessThan(this->_store[childOffset], this->_store[rightOffset])) {
+            childOffset = rightOffset;
+        }
+
+        if (!this->comparePriorityLessThan(key, this->_store[childOffset])) {
+            break;
+        }
+
+        this->_store[nodeOffset] = std::move(this->_store[childOffset]);
+        nodeOffset = childOffset;
+        childOffset = getLeftChildOffset(nodeOffset);
+        ++depth;
     }
 
-    return std::unique_ptr<size_t> {};
+    this->_store[nodeOffset] = std::move(key);
+    this->statistics.onMove(depth + 2);
+    this->statistics.onSiftDown(depth);
 }
 
-template <typename T>
-std::unique_ptr<size_t> Heap<T>::getRightChildOffset(size_t nodeOffset) {
-    auto childOffset = nodeOffset * 2 + 2;
-    if (childOffset < this->_store.size() && childOffset >= 0) {
-        return std::make_unique<size_t>(childOffset);
-    }
+template <typename T, typename Compare, typename Stats>
+Heap<T, Compare, Stats>::Heap(Heap &&rhs) noexcept
+: _store(std::move(rhs._store)), compare(std::move(rhs.compare)), statistics(std::move(rhs.statistics)) { }
 
-    return std::unique_ptr<size_t> {};
+template <typename T, typename Compare, typename Stats>
+T Heap<T, Compare, Stats>::top() const {
+    return static_cast<T>(this->_store[0]);
 }
 
-template <typename T>
-std::unique_ptr<size_t> Heap<T>::getParentOffset(size_t nodeOffset) {
-    if (nodeOffset < 0 || nodeOffset >= this->_store.size()) {
-        return std::unique_ptr<size_t> {};
-    }
+template <typename T, typename Compare, typename Stats>
+const T &Heap<T, Compare, Stats>::topRef() const {
+    return this->_store[0];
+}
 
-    size_t parentOffset = 0;
-    if (nodeOffset % 2 == 0) {
-        parentOffset = (nodeOffset - 2) / 2;
-    } else {
-        parentOffset = (nodeOffset - 1) / 2;
+template <typename T, typename Compare, typename Stats>
+std::vector<size_t> Heap<T, Compare, Stats>::findTopOffsets(size_t k) const {
+    std::vector<size_t> offsets;
+    if (k == 0) {
+        return offsets;
+    }
+    offsets.reserve(k);
+
+    // 辅助堆里放的是下标，比较的是下标指向的元素；候选集合永远是"已选出的节点的子节点"
+    auto compareOffsets = [this](size_t lhs, size_t rhs) {
+        return this->comparePriorityLessThan(this->_store[lhs], this->_store[rhs]);
+    };
+    Heap<size_t, decltype(compareOffsets)> candidates { compareOffsets };
+    candidates.insert(0);
+    while (offsets.size() < k) {
+        size_t nodeOffset = candidates.top();
+        candidates.pop();
+        offsets.push_back(nodeOffset);
+
+        size_t childOffset = getLeftChildOffset(nodeOffset);
+        if (childOffset < this->_store.size()) {
+            candidates.insert(childOffset);
+        }
+        if (childOffset + 1 < this->_store.size()) {
+            candidates.insert(childOffset + 1);
+        }
     }
 
-    if (parentOffset >= 0 && parentOffset < this->_store.size()) {
-        return std::make_unique<size_t>(parentOffset);
+    return offsets;
+}
+
+template <typename T, typename Compare, typename Stats>
+std::vector<std::reference_wrapper<const T>> Heap<T, Compare, Stats>::peekK(size_t k) const {
+    std::vector<std::reference_wrapper<const T>> result;
+    for (size_t nodeOffset : this->findTopOffsets(std::min(k, this->_store.size()))) {
+        result.emplace_back(this->_store[nodeOffset]);
     }
 
-    return std::unique_ptr<size_t> {};
+    return result;
 }
 
-template <typename T>
-void Heap<T>::reHeapifyBySink(size_t nodeOffset) {
-    if (this->_findHeapPropertyViolation(nodeOffset)) {
-        if (auto leftPtr = this->getLeftChildOffset(nodeOffset)) {
-            if (auto rightPtr = this->getRightChildOffset(nodeOffset)) {
-                if (this->compareGreaterThanOrEqual(*leftPtr, *rightPtr)) {
-                    this->swap(*leftPtr, nodeOffset);
-                    this->reHeapifyBySink(*leftPtr);
-                } else {
-                    this->swap(*rightPtr, nodeOffset);
-                    this->reHeapifyBySink(*rightPtr);
-                }
-            } else {
-                this->swap(*leftPtr, nodeOffset);
-                this->reHeapifyBySink(*leftPtr);
-            }
+template <typename T, typename Compare, typename Stats>
+template <typename OutputIt>
+OutputIt Heap<T, Compare, Stats>::popK(size_t k, OutputIt out) {
+    const size_t storeSize = this->_store.size();
+    k = std::min(k, storeSize);
+    if (k == 0) {
+        return out;
+    }
 
-        }
+    if (k == storeSize) {
+        std::sort(this->_store.begin(), this->_store.end(), [this](const T &lhs, const T &rhs) {
+            return this->comparePriorityLessThan(rhs, lhs);
+        });
+        out = std::move(this->_store.begin(), this->_store.end(), out);
+        this->statistics.onMove(storeSize);
+        this->_store.clear();
+        this->afterMutation();
+        return out;
     }
-}
 
-template <typename T>
-void Heap<T>::swap(size_t lhsOffset, size_t rhsOffset) {
-    T temp = this->_store[lhsOffset];
-    this->_store[lhsOffset] = this->_store[rhsOffset];
-    this->_store[rhsOffset] = temp;
-}
+    std::vector<size_t> holes = this->findTopOffsets(k);
+    for (size_t nodeOffset : holes) {
+        *out = std::move(this->_store[nodeOffset]);
+        ++out;
+    }
+    this->statistics.onMove(k);
+
+    // 末尾 k 个位置里没有被弹出的元素，依次填到前面的空洞里
+    std::sort(holes.begin(), holes.end());
+    const size_t remainingSize = storeSize - k;
+    auto tailHoles = std::lower_bound(holes.begin(), holes.end(), remainingSize);
+    auto nextTailHole = tailHoles;
+    auto nextFrontHole = holes.begin();
+    for (size_t tailOffset = remainingSize; tailOffset < storeSize; ++tailOffset) {
+        if (nextTailHole != holes.end() && *nextTailHole == tailOffset) {
+            ++nextTailHole;
+            continue;
+        }
 
-template <typename T>
-Heap<T>::Heap(Heap<T> &&rhs) noexcept : _store(std::move(rhs._store)) { }
+        this->_store[*nextFrontHole] = std::move(this->_store[tailOffset]);
+        this->statistics.onMove();
+        ++nextFrontHole;
+    }
+    this->_store.erase(this->_store.begin() + static_cast<std::ptrdiff_t>(remainingSize), this->_store.end());
 
-template <typename T>
-T Heap<T>::top() const {
-    return static_cast<T>(this->_store[0]);
+    // 空洞都在一棵包含根的子树里，按下标从大到小下沉时，每个位置的左右子树都已经是堆
+    for (auto it = tailHoles; it != holes.begin(); --it) {
+        this->reHeapifyBySink(*(it - 1));
+    }
+
+    this->afterMutation();
+    return out;
 }
 
-template <typename T>
-void Heap<T>::pop() {
+template <typename T, typename Compare, typename Stats>
+void Heap<T, Compare, Stats>::pop() {
     if (this->_store.empty()) {
         return;
     }
 
-    this->swap(0, this->_store.size()-1);
-    this->_store.pop_back();
-    if (!this->_store.empty()) {
-        this->reHeapifyBySink(0);
-    }
+    this->removeRoot();
+    this->afterMutation();
 }
 
-template <typename T>
-bool Heap<T>::empty() const {
-    return this->_store.empty();
+template <typename T, typename Compare, typename Stats>
+T Heap<T, Compare, Stats>::extract() {
+    T key = std::move(this->_store.front());
+    this->statistics.onMove();
+    this->removeRoot();
+    this->afterMutation();
+    return key;
 }
 
-template <typename T>
-bool Heap<T>::isHeapPropertySatisfied() {
-    return this->_isHeapPropertySatisfied(0);
+template <typename T, typename Compare, typename Stats>
+void Heap<T, Compare, Stats>::replaceTop(const T &key) {
+    this->_store.front() = key;
+    this->statistics.onMove();
+    this->reHeapifyBySink(0);
+    this->afterMutation();
 }
 
-template <typename T>
-bool Heap<T>::_isHeapPropertySatisfied(size_t nodeOffset) {
-    if (this->_findHeapPropertyViolation(nodeOffset)) {
-        return false;
-    }
+template <typename T, typename Compare, typename Stats>
+void Heap<T, Compare, Stats>::replaceTop(T &&key) {
+    this->_store.front() = std::move(key);
+    this->statistics.onMove();
+    this->reHeapifyBySink(0);
+    this->afterMutation();
+}
 
-    if (auto leftPtr = this->getLeftChildOffset(nodeOffset)) {
-        if (!this->_isHeapPropertySatisfied(*leftPtr)) {
-            return false;
-        }
+template <typename T, typename Compare, typename Stats>
+void Heap<T, Compare, Stats>::removeRoot() {
+    // 把最后一个元素挪到根部留下的空洞里，然后让它下沉
+    if (this->_store.size() > 1) {
+        this->_store.front() = std::move(this->_store.back());
+        this->statistics.onMove();
+        this->_store.pop_back();
+        this->reHeapifyBySink(0);
+    } else {
+        this->_store.pop_back();
     }
+}
+
+template <typename T, typename Compare, typename Stats>
+bool Heap<T, Compare, Stats>::empty() const {
+    return this->_store.empty();
+}
 
-    if (auto rightPtr = this->getRightChildOffset(nodeOffset)) {
-        if (!this->_isHeapPropertySatisfied(*rightPtr)) {
+template <typename T, typename Compare, typename Stats>
+bool Heap<T, Compare, Stats>::isHeapPropertySatisfied() const {
+    for (size_t nodeOffset = 1; nodeOffset < this->_store.size(); ++nodeOffset) {
+        if (this->compare(this->_store[getParentOffset(nodeOffset)], this->_store[nodeOffset])) {
             return false;
         }
     }
@@ -248,61 +470,101 @@ bool Heap<T>::_isHeapPropertySatisfied(size_t nodeOffset) {
     return true;
 }
 
-template <typename T>
-std::unique_ptr<size_t> Heap<T>::_findHeapPropertyViolation(size_t nodeOffset) {
-    auto emptyPtr = std::unique_ptr<size_t> {};
-    if (nodeOffset >= this->_store.size()) {
-        return emptyPtr;
-    }
+template <typename T, typename Compare, typename Stats>
+const Stats &Heap<T, Compare, Stats>::stats() const {
+    return this->statistics;
+}
 
-    if (auto leftPtr = this->getLeftChildOffset(nodeOffset)) {
-        if (!this->compareGreaterThanOrEqual(nodeOffset, *leftPtr)) {
-            return std::move(leftPtr);
-        }
-    }
+template <typename T, typename Compare, typename Stats>
+Stats &Heap<T, Compare, Stats>::stats() {
+    return this->statistics;
+}
 
-    if (auto rightPtr = this->getRightChildOffset(nodeOffset)) {
-        if (!this->compareGreaterThanOrEqual(nodeOffset, *rightPtr)) {
-            return std::move(rightPtr);
-        }
+template <typename T, typename Compare, typename Stats>
+void Heap<T, Compare, Stats>::afterMutation() {
+    this->statistics.onSize(this->_store.size());
+    if constexpr (Stats::validatesAfterMutation) {
+        assert((this->isHeapPropertySatisfied()));
     }
+}
 
-    return emptyPtr;
+template <typename T, typename Compare, typename Stats>
+bool Heap<T, Compare, Stats>::comparePriorityLessThan(const T &lhs, const T &rhs) const {
+    this->statistics.onCompare();
+    return this->compare(lhs, rhs);
 }
 
-template <typename T>
-bool Heap<T>::compareGreaterThanOrEqual(size_t lhsNodeOffset, size_t rhsNodeOffset) const {
-    return this->comparator(this->_store[lhsNodeOffset], this->_store[rhsNodeOffset]);
+template <typename T, typename Compare, typename Stats>
+void Heap<T, Compare, Stats>::fullReHeapify() {
+    for (size_t ptr = this->_store.size() / 2; ptr > 0; --ptr) {
+        this->reHeapifyBySink(ptr - 1);
+    }
 }
 
-template <typename T>
-void Heap<T>::fullReHeapify() {
-    if (!this->_store.empty()) {
-        for (size_t ptr = 0; ptr < this->_store.size(); ++ptr) {
-            this->reHeapifyByFloat(ptr+1);
+template <typename T, typename Compare, typename Stats>
+bool Heap<T, Compare, Stats>::shouldRebuildForBatch(size_t existingCount, size_t batchCount) noexcept {
+    // 逐个上浮最坏要 batchCount * log2(n) 次比较，重建大约要 2n 次比较，
+    // 实际上随机数据的上浮平均只有常数层，所以给逐个上浮打个折扣。
+    size_t totalCount = existingCount + batchCount;
+    size_t depth = std::bit_width(totalCount);
+    return batchCount * depth >= totalCount * 4;
+}
+
+template <typename T, typename Compare, typename Stats>
+template <std::ranges::input_range Range>
+void Heap<T, Compare, Stats>::pushBulk(Range &&range, BulkInsertStrategy strategy) {
+    size_t existingCount = this->_store.size();
+    if constexpr (std::ranges::sized_range<Range>) {
+        this->_store.reserve(existingCount + std::ranges::size(range));
+    }
+
+    // 传进来的是一个右值的容器（而不是视图）时，它的元素可以被移走
+    constexpr bool canMoveElements = !std::is_lvalue_reference_v<Range> && !std::ranges::view<std::remove_cvref_t<Range>>;
+    for (auto &&key : range) {
+        if constexpr (canMoveElements) {
+            this->_store.emplace_back(std::move(key));
+        } else {
+            this->_store.emplace_back(std::forward<decltype(key)>(key));
+        }
+    }
+
+    size_t batchCount = this->_store.size() - existingCount;
+    if (strategy == BulkInsertStrategy::Auto) {
+        strategy = shouldRebuildForBatch(existingCount, batchCount) ? BulkInsertStrategy::Rebuild : BulkInsertStrategy::Incremental;
+    }
+
+    if (strategy == BulkInsertStrategy::Rebuild) {
+        this->fullReHeapify();
+    } else {
+        for (size_t ptr = existingCount; ptr < this->_store.size(); ++ptr) {
+            this->reHeapifyByFloat(ptr);
         }
     }
+
+    this->afterMutation();
 }
 
-template <typename T>
-Heap<T>::Heap(std::vector<T> &&heapStorageArray, const Comparator<T> &_comparator)
-: _store(std::move(heapStorageArray)), comparator(_comparator) {
+template <typename T, typename Compare, typename Stats>
+Heap<T, Compare, Stats>::Heap(std::vector<T> &&heapStorageArray, const Compare &_compare)
+: _store(std::move(heapStorageArray)), compare(_compare), statistics() {
     this->fullReHeapify();
+    this->afterMutation();
 }
 
-template <typename T>
-void Heap<T>::updateComparator(const Comparator<T> &_comparator) {
-    this->comparator = _comparator;
+template <typename T, typename Compare, typename Stats>
+void Heap<T, Compare, Stats>::updateComparator(const Compare &_compare) {
+    this->compare = _compare;
     this->fullReHeapify();
+    this->afterMutation();
 }
 
-template <typename T>
-void Heap<T>::clear() {
+template <typename T, typename Compare, typename Stats>
+void Heap<T, Compare, Stats>::clear() {
     this->_store.clear();
 }
 
-template <typename T>
-size_t Heap<T>::size() const {
+template <typename T, typename Compare, typename Stats>
+size_t Heap<T, Compare, Stats>::size() const {
     return this->_store.size();
 }
 
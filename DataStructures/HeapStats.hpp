@@ -0,0 +1,110 @@
+#ifndef DATASTRUCTUREIMPLEMENTATIONS_HEAPSTATS_HPP
+#define DATASTRUCTUREIMPLEMENTATIONS_HEAPSTATS_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+/**
+ * Heap 的统计策略，作为 Heap 的第三个模板参数传入。
+ * Heap 在比较、移动元素、上浮、下沉、规模变化时调用策略的对应钩子，
+ * validatesAfterMutation 为 true 时还会在每一次修改之后用 assert 检查一遍堆性。
+ */
+
+/** 默认的策略：什么都不做，钩子全部内联成空函数，空类也不占 Heap 的空间 */
+struct NoHeapStats {
+    static constexpr bool validatesAfterMutation = false;
+
+    void onCompare() const noexcept { }
+    void onMove(size_t = 1) const noexcept { }
+    void onSiftUp(size_t) const noexcept { }
+    void onSiftDown(size_t) const noexcept { }
+    void onSize(size_t) const noexcept { }
+};
+
+/** 计数的策略：比较次数、移动次数、上浮和下沉的层数分布、历史最大规模 */
+class CountingHeapStats {
+public:
+    static constexpr bool validatesAfterMutation = false;
+
+    /** 直方图的桶数，层数超过它的都记在最后一个桶里 */
+    static constexpr size_t histogramSize = 64;
+
+    void onCompare() noexcept {
+        ++this->comparisons;
+    }
+
+    void onMove(size_t count = 1) noexcept {
+        this->moves += count;
+    }
+
+    void onSiftUp(size_t depth) noexcept {
+        ++this->siftUpDepths[std::min(depth, histogramSize - 1)];
+    }
+
+    void onSiftDown(size_t depth) noexcept {
+        ++this->siftDownDepths[std::min(depth, histogramSize - 1)];
+    }
+
+    void onSize(size_t size) noexcept {
+        this->maxSize = std::max(this->maxSize, size);
+    }
+
+    /** 清零所有计数 */
+    void reset() noexcept {
+        *this = CountingHeapStats {};
+    }
+
+    /** 打印所有计数，以及上浮、下沉层数的直方图 */
+    void dump(std::ostream &os = std::cout) const {
+        os << "comparisons: " << this->comparisons << "\n"
+           << "moves: " << this->moves << "\n"
+           << "max size: " << this->maxSize << "\n";
+        dumpHistogram(os, "sift-up depth", this->siftUpDepths);
+        dumpHistogram(os, "sift-down depth", this->siftDownDepths);
+    }
+
+    uint64_t comparisons = 0;
+    uint64_t moves = 0;
+    size_t maxSize = 0;
+
+    /** 第 d 个桶是移动了 d 层的上浮（下沉）次数 */
+    std::array<uint64_t, histogramSize> siftUpDepths {};
+    std::array<uint64_t, histogramSize> siftDownDepths {};
+
+private:
+    static void dumpHistogram(std::ostream &os, const std::string &title, const std::array<uint64_t, histogramSize> &histogram) {
+        uint64_t total = 0;
+        uint64_t weighted = 0;
+        uint64_t peak = 0;
+        size_t lastNonEmpty = 0;
+        for (size_t depth = 0; depth < histogramSize; ++depth) {
+            total += histogram[depth];
+            weighted += histogram[depth] * depth;
+            peak = std::max(peak, histogram[depth]);
+            if (histogram[depth] > 0) {
+                lastNonEmpty = depth;
+            }
+        }
+
+        os << title << ": " << total << " sifts, mean " << (total > 0 ? static_cast<double>(weighted) / static_cast<double>(total) : 0.0) << "\n";
+        if (total == 0) {
+            return;
+        }
+
+        constexpr size_t barWidth = 40;
+        for (size_t depth = 0; depth <= lastNonEmpty; ++depth) {
+            size_t bar = static_cast<size_t>(histogram[depth] * barWidth / peak);
+            os << "  " << (depth + 1 == histogramSize ? ">=" : "  ") << depth << "\t" << histogram[depth] << "\t" << std::string(bar, '#') << "\n";
+        }
+    }
+};
+
+/** 调试用的策略：在计数的基础上，每次修改之后都检查一遍堆性（O(n), 只在调试构建中使用） */
+struct ValidatingHeapStats : CountingHeapStats {
+    static constexpr bool validatesAfterMutation = true;
+};
+
+#endif //DATASTRUCTUREIMPLEMENTATIONS_HEAPSTATS_HPP
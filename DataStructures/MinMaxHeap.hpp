@@ -0,0 +1,298 @@
+#ifndef DATASTRUCTUREIMPLEMENTATIONS_MINMAXHEAP_HPP
+#define DATASTRUCTUREIMPLEMENTATIONS_MINMAXHEAP_HPP
+
+#include <bit>
+#include <cassert>
+#include <functional>
+#include <utility>
+#include <vector>
+
+/**
+ * 双端的最小-最大堆，和 Heap<T, Compare> 一样只用一个 std::vector<T> 作为存储区域。
+ *
+ * 主要思路：
+ * 按照层数区分节点，偶数层（根在第 0 层）是"最小层"，奇数层是"最大层"，
+ * 最小层的节点不大于它的所有后代，最大层的节点不小于它的所有后代，
+ * 于是最小的元素就是根，最大的元素是根的两个子节点之一，min() / max() 都是 O(1),
+ * 插入时沿着祖父节点链在同类的层中上浮，删除时沿着孙子节点链在同类的层中下沉，都是 O(log n).
+ *
+ * 这里的"大""小"是相对于 Compare 而言的：compare(a, b) 为 true 表示 a 小于 b.
+ * 典型的用法是维护有界的 "best N" 集合：插入之后若超过 N 个元素就 popMin() 淘汰最差的那个，
+ * 需要的时候用 max() / popMax() 取出最好的那个。
+ */
+template <typename T, typename Compare = std::less<>>
+class MinMaxHeap {
+public:
+    /** 构造一个空堆，可以指定 key 的排序准则 */
+    explicit MinMaxHeap(const Compare& compare = Compare());
+
+    /** 通过堆化一个 std::vector<T> 实例建立堆，O(n) */
+    MinMaxHeap(std::vector<T>&& heapStorageArray, const Compare& compare = Compare());
+
+    /** 不允许复制 */
+    MinMaxHeap(const MinMaxHeap& rhs) = delete;
+
+    /** 可移动 */
+    MinMaxHeap(MinMaxHeap&& rhs) noexcept = default;
+
+    /** 插入一个元素 */
+    void insert(const T& key);
+
+    /** 以移动的方式插入一个元素 */
+    void insert(T&& key);
+
+    /** 查看最小的元素，堆不得为空 */
+    [[nodiscard]] const T& min() const;
+
+    /** 查看最大的元素，堆不得为空 */
+    [[nodiscard]] const T& max() const;
+
+    /** 弹出最小的元素 */
+    void popMin();
+
+    /** 弹出最大的元素 */
+    void popMax();
+
+    /** 清除堆的所有元素 */
+    void clear();
+
+    /** 检查这个堆是否是空堆 */
+    [[nodiscard]] bool empty() const;
+
+    /** 返回元素的个数 */
+    [[nodiscard]] size_t size() const;
+
+private:
+    /** 堆的存储区域 */
+    std::vector<T> _store;
+
+    /** 比较器 */
+    [[no_unique_address]] Compare compare;
+
+    /** nodeOffset 是否位于最小层 */
+    static bool isOnMinLevel(size_t nodeOffset) noexcept;
+
+    /** 最大元素所在的下标，堆不得为空 */
+    [[nodiscard]] size_t maxOffset() const;
+
+    /** 新插入到 nodeOffset 的元素上浮 */
+    void pushUp(size_t nodeOffset);
+
+    /** 沿着祖父节点链上浮，IsMinLevel 决定走的是最小层还是最大层 */
+    template <bool IsMinLevel>
+    void pushUpAlong(size_t nodeOffset);
+
+    /** nodeOffset 处的元素下沉 */
+    void trickleDown(size_t nodeOffset);
+
+    /** 沿着孙子节点链下沉，IsMinLevel 决定走的是最小层还是最大层 */
+    template <bool IsMinLevel>
+    void trickleDownAlong(size_t nodeOffset);
+
+    /** 删除 nodeOffset 处的元素，用最后一个元素填补后下沉 */
+    void removeAt(size_t nodeOffset);
+
+    /** 在最小层上比较时 lhs 是否应该排在 rhs 的上面，IsMinLevel 为 false 时反过来 */
+    template <bool IsMinLevel>
+    [[nodiscard]] bool goesAbove(const T& lhs, const T& rhs) const;
+};
+
+template <typename T, typename Compare>
+MinMaxHeap<T, Compare>::MinMaxHeap(const Compare &_compare) : _store(), compare(_compare) { }
+
+template <typename T, typename Compare>
+MinMaxHeap<T, Compare>::MinMaxHeap(std::vector<T> &&heapStorageArray, const Compare &_compare)
+: _store(std::move(heapStorageArray)), compare(_compare) {
+    for (size_t ptr = this->_store.size() / 2; ptr > 0; --ptr) {
+        this->trickleDown(ptr - 1);
+    }
+}
+
+template <typename T, typename Compare>
+bool MinMaxHeap<T, Compare>::isOnMinLevel(size_t nodeOffset) noexcept {
+    // 第 L 层的下标范围是 [2^L - 1, 2^(L+1) - 1), 所以层数就是 bit_width(nodeOffset + 1) - 1
+    return (std::bit_width(nodeOffset + 1) - 1) % 2 == 0;
+}
+
+template <typename T, typename Compare>
+template <bool IsMinLevel>
+bool MinMaxHeap<T, Compare>::goesAbove(const T &lhs, const T &rhs) const {
+    if constexpr (IsMinLevel) {
+        return this->compare(lhs, rhs);
+    } else {
+        return this->compare(rhs, lhs);
+    }
+}
+
+template <typename T, typename Compare>
+void MinMaxHeap<T, Compare>::insert(const T &key) {
+    this->_store.push_back(key);
+    this->pushUp(this->_store.size() - 1);
+}
+
+template <typename T, typename Compare>
+void MinMaxHeap<T, Compare>::insert(T &&key) {
+    this->_store.push_back(std::move(key));
+    this->pushUp(this->_store.size() - 1);
+}
+
+template <typename T, typename Compare>
+void MinMaxHeap<T, Compare>::pushUp(size_t nodeOffset) {
+    if (nodeOffset == 0) {
+        return;
+    }
+
+    size_t parentOffset = (nodeOffset - 1) / 2;
+    if (isOnMinLevel(nodeOffset)) {
+        // 父节点在最大层，比父节点还大就先和它交换，然后在最大层中继续上浮
+        if (this->compare(this->_store[parentOffset], this->_store[nodeOffset])) {
+            std::swap(this->_store[parentOffset], this->_store[nodeOffset]);
+            this->template pushUpAlong<false>(parentOffset);
+        } else {
+            this->template pushUpAlong<true>(nodeOffset);
+        }
+    } else {
+        if (this->compare(this->_store[nodeOffset], this->_store[parentOffset])) {
+            std::swap(this->_store[parentOffset], this->_store[nodeOffset]);
+            this->template pushUpAlong<true>(parentOffset);
+        } else {
+            this->template pushUpAlong<false>(nodeOffset);
+        }
+    }
+}
+
+template <typename T, typename Compare>
+template <bool IsMinLevel>
+void MinMaxHeap<T, Compare>::pushUpAlong(size_t nodeOffset) {
+    T key = std::move(this->_store[nodeOffset]);
+    while (nodeOffset >= 3) {
+        size_t grandparentOffset = ((nodeOffset - 1) / 2 - 1) / 2;
+        if (!this->template goesAbove<IsMinLevel>(key, this->_store[grandparentOffset])) {
+            break;
+        }
+
+        this->_store[nodeOffset] = std::move(this->_store[grandparentOffset]);
+        nodeOffset = grandparentOffset;
+    }
+
+    this->_store[nodeOffset] = std::move(key);
+}
+
+template <typename T, typename Compare>
+void MinMaxHeap<T, Compare>::trickleDown(size_t nodeOffset) {
+    if (isOnMinLevel(nodeOffset)) {
+        this->template trickleDownAlong<true>(nodeOffset);
+    } else {
+        this->template trickleDownAlong<false>(nodeOffset);
+    }
+}
+
+template <typename T, typename Compare>
+template <bool IsMinLevel>
+void MinMaxHeap<T, Compare>::trickleDownAlong(size_t nodeOffset) {
+    const size_t storeSize = this->_store.size();
+    while (true) {
+        size_t firstChild = nodeOffset * 2 + 1;
+        if (firstChild >= storeSize) {
+            return;
+        }
+
+        // 在子节点和孙子节点中找出最应该排在上面的那个
+        size_t bestOffset = firstChild;
+        size_t candidates[] = { firstChild + 1, firstChild * 2 + 1, firstChild * 2 + 2, firstChild * 2 + 3, firstChild * 2 + 4 };
+        for (size_t candidate : candidates) {
+            if (candidate < storeSize && this->template goesAbove<IsMinLevel>(this->_store[candidate], this->_store[bestOffset])) {
+                bestOffset = candidate;
+            }
+        }
+
+        if (!this->template goesAbove<IsMinLevel>(this->_store[bestOffset], this->_store[nodeOffset])) {
+            return;
+        }
+
+        std::swap(this->_store[bestOffset], this->_store[nodeOffset]);
+        if (bestOffset <= firstChild + 1) {
+            // 是子节点：它在另一类层上，交换之后就不需要再往下走了
+            return;
+        }
+
+        // 是孙子节点：换下去的元素可能违反了它和父节点（另一类层）之间的关系
+        size_t parentOffset = (bestOffset - 1) / 2;
+        if (this->template goesAbove<IsMinLevel>(this->_store[parentOffset], this->_store[bestOffset])) {
+            std::swap(this->_store[parentOffset], this->_store[bestOffset]);
+        }
+        nodeOffset = bestOffset;
+    }
+}
+
+template <typename T, typename Compare>
+size_t MinMaxHeap<T, Compare>::maxOffset() const {
+    if (this->_store.size() == 1) {
+        return 0;
+    }
+
+    if (this->_store.size() == 2 || !this->compare(this->_store[1], this->_store[2])) {
+        return 1;
+    }
+
+    return 2;
+}
+
+template <typename T, typename Compare>
+const T &MinMaxHeap<T, Compare>::min() const {
+    assert((!this->_store.empty()));
+    return this->_store[0];
+}
+
+template <typename T, typename Compare>
+const T &MinMaxHeap<T, Compare>::max() const {
+    assert((!this->_store.empty()));
+    return this->_store[this->maxOffset()];
+}
+
+template <typename T, typename Compare>
+void MinMaxHeap<T, Compare>::removeAt(size_t nodeOffset) {
+    if (nodeOffset + 1 == this->_store.size()) {
+        this->_store.pop_back();
+        return;
+    }
+
+    this->_store[nodeOffset] = std::move(this->_store.back());
+    this->_store.pop_back();
+    this->trickleDown(nodeOffset);
+}
+
+template <typename T, typename Compare>
+void MinMaxHeap<T, Compare>::popMin() {
+    if (this->_store.empty()) {
+        return;
+    }
+
+    this->removeAt(0);
+}
+
+template <typename T, typename Compare>
+void MinMaxHeap<T, Compare>::popMax() {
+    if (this->_store.empty()) {
+        return;
+    }
+
+    this->removeAt(this->maxOffset());
+}
+
+template <typename T, typename Compare>
+void MinMaxHeap<T, Compare>::clear() {
+    this->_store.clear();
+}
+
+template <typename T, typename Compare>
+bool MinMaxHeap<T, Compare>::empty() const {
+    return this->_store.empty();
+}
+
+template <typename T, typename Compare>
+size_t MinMaxHeap<T, Compare>::size() const {
+    return this->_store.size();
+}
+
+#endif //DATASTRUCTUREIMPLEMENTATIONS_MINMAXHEAP_HPP
@@ -0,0 +1,190 @@
+#ifndef DATASTRUCTUREIMPLEMENTATIONS_MULTIQUEUE_HPP
+#define DATASTRUCTUREIMPLEMENTATIONS_MULTIQUEUE_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "Heap.hpp"
+
+/**
+ * MultiQueue: 多生产者、多消费者的并发（松弛）优先队列。
+ *
+ * 主要思路：
+ * 内部有 shardCount 个各自带锁的 Heap<T, Compare>,
+ * - insert 随机挑一个分片，try_lock 失败就换一个分片再试，从不阻塞在锁上；
+ * - tryPop 随机挑两个分片，取两者堆顶中优先级更高的那个弹出；
+ * 所以它不保证每次弹出的都是全局优先级最高的元素，而是"近似最高"：
+ * 弹出元素在全局的期望排名是 O(shardCount) 的，shardCount 就是松弛程度的上界，
+ * 通常取 线程数 * queuesPerThread（queuesPerThread 取 2 到 4），分片越多争用越少，但是越不精确。
+ *
+ * 线程安全：insert / tryPop / size / empty 都可以在多个线程中同时调用。
+ */
+template <typename T, typename Compare = std::less<>>
+class MultiQueue {
+public:
+    /** 按照 threadCount * queuesPerThread 个分片构造，queuesPerThread 越大松弛越大、争用越小 */
+    explicit MultiQueue(size_t threadCount, size_t queuesPerThread = 2, const Compare& compare = Compare());
+
+    /** 不允许复制 */
+    MultiQueue(const MultiQueue& rhs) = delete;
+
+    /** 插入一个元素 */
+    void insert(const T& key);
+
+    /** 尝试弹出一个（近似）优先级最高的元素，队列为空时返回 false */
+    bool tryPop(T& out);
+
+    /** 当前元素的个数，并发修改时只是一个近似值 */
+    [[nodiscard]] size_t size() const;
+
+    /** 是否为空，并发修改时只是一个近似值 */
+    [[nodiscard]] bool empty() const;
+
+    /** 分片个数，即松弛程度的上界 */
+    [[nodiscard]] size_t shardCount() const;
+
+private:
+    /** 一个分片，独占一条缓存行，避免相邻分片的锁互相干扰 */
+    struct alignas(64) Shard {
+        explicit Shard(const Compare& compare) : lock(), heap(compare), count(0) { }
+
+        std::mutex lock;
+        Heap<T, Compare> heap;
+
+        /** 分片中元素的个数，不持锁也可以读取，用来快速跳过空的分片 */
+        std::atomic<size_t> count;
+    };
+
+    std::vector<std::unique_ptr<Shard>> shards;
+    std::atomic<size_t> totalCount;
+    [[no_unique_address]] Compare compare;
+
+    /** 每个线程自己的 xorshift 随机数发生器，返回 [0, shards.size()) 中的一个下标 */
+    size_t randomShardIndex();
+
+    /** 在已经持有锁的分片上弹出堆顶 */
+    void popLocked(Shard& shard, T& out);
+};
+
+template <typename T, typename Compare>
+MultiQueue<T, Compare>::MultiQueue(size_t threadCount, size_t queuesPerThread, const Compare &_compare)
+: shards(), totalCount(0), compare(_compare) {
+    size_t shardCount = std::max<size_t>(2, threadCount * queuesPerThread);
+    this->shards.reserve(shardCount);
+    for (size_t i = 0; i < shardCount; ++i) {
+        this->shards.push_back(std::make_unique<Shard>(_compare));
+    }
+}
+
+template <typename T, typename Compare>
+size_t MultiQueue<T, Compare>::randomShardIndex() {
+    thread_local uint64_t state = std::hash<std::thread::id> {}(std::this_thread::get_id()) | 1;
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return static_cast<size_t>(state % this->shards.size());
+}
+
+template <typename T, typename Compare>
+void MultiQueue<T, Compare>::insert(const T &key) {
+    while (true) {
+        Shard &shard = *this->shards[this->randomShardIndex()];
+        std::unique_lock<std::mutex> guard (shard.lock, std::try_to_lock);
+        if (!guard.owns_lock()) {
+            continue;
+        }
+
+        shard.heap.insert(key);
+        shard.count.store(shard.heap.size(), std::memory_order_relaxed);
+        this->totalCount.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+}
+
+template <typename T, typename Compare>
+void MultiQueue<T, Compare>::popLocked(Shard &shard, T &out) {
+    out = shard.heap.extract();
+    shard.count.store(shard.heap.size(), std::memory_order_relaxed);
+    this->totalCount.fetch_sub(1, std::memory_order_relaxed);
+}
+
+template <typename T, typename Compare>
+bool MultiQueue<T, Compare>::tryPop(T &out) {
+    // 随机挑两个分片，先试几轮，多数情况下在这里就能成功
+    for (size_t attempt = 0; attempt < this->shards.size() * 2; ++attempt) {
+        if (this->totalCount.load(std::memory_order_relaxed) == 0) {
+            break;
+        }
+
+        Shard &first = *this->shards[this->randomShardIndex()];
+        Shard &second = *this->shards[this->randomShardIndex()];
+        if (&first == &second || second.count.load(std::memory_order_relaxed) == 0) {
+            if (first.count.load(std::memory_order_relaxed) == 0) {
+                continue;
+            }
+
+            std::unique_lock<std::mutex> guard (first.lock, std::try_to_lock);
+            if (guard.owns_lock() && !first.heap.empty()) {
+                this->popLocked(first, out);
+                return true;
+            }
+            continue;
+        }
+
+        std::unique_lock<std::mutex> secondGuard (second.lock, std::try_to_lock);
+        if (!secondGuard.owns_lock()) {
+            continue;
+        }
+
+        std::unique_lock<std::mutex> firstGuard (first.lock, std::try_to_lock);
+        bool firstUsable = firstGuard.owns_lock() && !first.heap.empty();
+        bool secondUsable = !second.heap.empty();
+        if (firstUsable && (!secondUsable || !this->compare(first.heap.topRef(), second.heap.topRef()))) {
+            this->popLocked(first, out);
+            return true;
+        }
+
+        if (secondUsable) {
+            this->popLocked(second, out);
+            return true;
+        }
+    }
+
+    // 随机尝试都落空了，依次检查每一个分片，确认是否真的为空
+    for (auto &shardPtr : this->shards) {
+        Shard &shard = *shardPtr;
+        if (shard.count.load(std::memory_order_relaxed) == 0) {
+            continue;
+        }
+
+        std::lock_guard<std::mutex> guard (shard.lock);
+        if (!shard.heap.empty()) {
+            this->popLocked(shard, out);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+template <typename T, typename Compare>
+size_t MultiQueue<T, Compare>::size() const {
+    return this->totalCount.load(std::memory_order_relaxed);
+}
+
+template <typename T, typename Compare>
+bool MultiQueue<T, Compare>::empty() const {
+    return this->size() == 0;
+}
+
+template <typename T, typename Compare>
+size_t MultiQueue<T, Compare>::shardCount() const {
+    return this->shards.size();
+}
+
+#endif //DATASTRUCTUREIMPLEMENTATIONS_MULTIQUEUE_HPP
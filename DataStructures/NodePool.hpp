@@ -0,0 +1,140 @@
+#ifndef DATASTRUCTUREIMPLEMENTATIONS_NODEPOOL_HPP
+#define DATASTRUCTUREIMPLEMENTATIONS_NODEPOOL_HPP
+
+#include <cstddef>
+#include <new>
+#include <utility>
+
+/**
+ * 节点池：按块（每块 ChunkSize 个节点）向系统申请内存，块内的空闲槽位串成一条单链表，
+ * create / destroy 都是 O(1) 的，并且不会为每一个节点单独调用 new / delete.
+ *
+ * 块之间也串成一条链表，所以两个节点池可以在 O(1) 内合并（adopt），
+ * 这让基于指针的可合并堆在 meld 的时候能把对方的节点连同内存一起接管过来。
+ *
+ * 节点池本身不知道哪些槽位上还有活着的节点，所以析构时不会调用节点的析构函数，
+ * 这件事由使用者（各个堆）在析构之前负责。
+ */
+template <typename Node, size_t ChunkSize = 256>
+class NodePool {
+public:
+    NodePool() noexcept : chunkHead(nullptr), freeHead(nullptr), freeTail(nullptr) { }
+
+    /** 不允许复制 */
+    NodePool(const NodePool& rhs) = delete;
+
+    /** 移动之后 rhs 变为空池 */
+    NodePool(NodePool&& rhs) noexcept
+    : chunkHead(std::exchange(rhs.chunkHead, nullptr)),
+      freeHead(std::exchange(rhs.freeHead, nullptr)),
+      freeTail(std::exchange(rhs.freeTail, nullptr)) { }
+
+    NodePool& operator=(NodePool&& rhs) noexcept {
+        if (this != &rhs) {
+            this->releaseChunks();
+            this->chunkHead = std::exchange(rhs.chunkHead, nullptr);
+            this->freeHead = std::exchange(rhs.freeHead, nullptr);
+            this->freeTail = std::exchange(rhs.freeTail, nullptr);
+        }
+
+        return *this;
+    }
+
+    ~NodePool() {
+        this->releaseChunks();
+    }
+
+    /** 在一个空闲槽位上构造一个节点 */
+    template <typename... Args>
+    Node* create(Args&&... args) {
+        if (!this->freeHead) {
+            this->allocateChunk();
+        }
+
+        Slot* slot = this->freeHead;
+        this->freeHead = slot->next;
+        if (!this->freeHead) {
+            this->freeTail = nullptr;
+        }
+
+        return ::new (static_cast<void*>(slot->storage)) Node(std::forward<Args>(args)...);
+    }
+
+    /** 析构一个节点并回收它的槽位 */
+    void destroy(Node* node) noexcept {
+        node->~Node();
+        auto slot = reinterpret_cast<Slot*>(node);
+        slot->next = this->freeHead;
+        this->freeHead = slot;
+        if (!this->freeTail) {
+            this->freeTail = slot;
+        }
+    }
+
+    /** 接管另一个节点池的全部内存（包括其上活着的节点），O(1), 之后 rhs 变为空池 */
+    void adopt(NodePool&& rhs) noexcept {
+        if (rhs.chunkHead) {
+            Chunk* rhsChunkTail = rhs.chunkHead->tail;
+            Chunk* mergedTail = this->chunkHead ? this->chunkHead->tail : rhsChunkTail;
+            rhsChunkTail->next = this->chunkHead;
+            this->chunkHead = std::exchange(rhs.chunkHead, nullptr);
+            this->chunkHead->tail = mergedTail;
+        }
+
+        if (rhs.freeHead) {
+            rhs.freeTail->next = this->freeHead;
+            if (!this->freeTail) {
+                this->freeTail = rhs.freeTail;
+            }
+            this->freeHead = rhs.freeHead;
+        }
+
+        rhs.freeHead = nullptr;
+        rhs.freeTail = nullptr;
+    }
+
+private:
+    /** 一个槽位：空闲时存放下一个空闲槽位的指针，被占用时存放节点 */
+    union Slot {
+        Slot* next;
+        alignas(Node) std::byte storage[sizeof(Node)];
+    };
+
+    /** 一块内存，块与块串成单链表，链表头那一块的 tail 记录着链表上的最后一块 */
+    struct Chunk {
+        Chunk* next;
+        Chunk* tail;
+        Slot slots[ChunkSize];
+    };
+
+    Chunk* chunkHead;
+    Slot* freeHead;
+    Slot* freeTail;
+
+    /** 申请新的一块，并把它的所有槽位串到空闲链表上 */
+    void allocateChunk() {
+        auto chunk = new Chunk;
+        chunk->next = this->chunkHead;
+        chunk->tail = this->chunkHead ? this->chunkHead->tail : chunk;
+        this->chunkHead = chunk;
+
+        for (size_t i = 0; i + 1 < ChunkSize; ++i) {
+            chunk->slots[i].next = &chunk->slots[i + 1];
+        }
+        chunk->slots[ChunkSize - 1].next = this->freeHead;
+        if (!this->freeHead) {
+            this->freeTail = &chunk->slots[ChunkSize - 1];
+        }
+        this->freeHead = &chunk->slots[0];
+    }
+
+    void releaseChunks() noexcept {
+        while (this->chunkHead) {
+            delete std::exchange(this->chunkHead, this->chunkHead->next);
+        }
+        this->freeHead = nullptr;
+        this->freeTail = nullptr;
+    }
+};
+
+#endif //DATASTRUCTUREIMPLEMENTATIONS_NODEPOOL_HPP
@@ -0,0 +1,340 @@
+#ifndef DATASTRUCTUREIMPLEMENTATIONS_PAIRINGHEAP_HPP
+#define DATASTRUCTUREIMPLEMENTATIONS_PAIRINGHEAP_HPP
+
+#include <cassert>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "NodePool.hpp"
+
+/**
+ * 配对堆：一棵多叉树，每个节点的优先级都不低于它的子节点。
+ * - insert / meld / top: O(1)
+ * - pop: 均摊 O(log n), 采用经典的两趟配对（先从左到右两两合并，再从右到左依次合并）
+ * - increaseKey: 均摊 o(log n), 把节点连同子树剪下来再和根合并
+ * - decreaseKey / erase: 均摊 O(log n)
+ *
+ * Compare 以及 increaseKey / decreaseKey 的约定和 AddressableHeap 相同。
+ * 节点从 NodePool 中分配，meld 时连同对方的节点池一起接管，不需要逐个复制节点。
+ */
+template <typename T, typename Compare = std::less<>>
+class PairingHeap {
+    struct Node;
+
+public:
+    /** 元素的句柄，在元素被 pop 或者 erase 之前一直有效，meld 之后仍然有效 */
+    using Handle = Node*;
+
+    /** 构造一个空堆，可以指定 key 的排序准则 */
+    explicit PairingHeap(const Compare& compare = Compare());
+
+    /** 不允许复制 */
+    PairingHeap(const PairingHeap& rhs) = delete;
+
+    /** 可移动 */
+    PairingHeap(PairingHeap&& rhs) noexcept;
+
+    ~PairingHeap();
+
+    /** 插入一个元素，返回它的句柄 */
+    Handle insert(const T& key);
+
+    /** 查看堆顶部的元素 */
+    [[nodiscard]] T top() const;
+
+    /** 弹出堆顶部的元素 */
+    void pop();
+
+    /** 把 rhs 的全部元素并入本堆，O(1), 之后 rhs 变为空堆，rhs 上的句柄转而属于本堆 */
+    void meld(PairingHeap&& rhs);
+
+    /** 查看句柄对应的元素 */
+    [[nodiscard]] const T& get(Handle handle) const;
+
+    /** 把句柄对应的元素替换为一个优先级不低于它的新 key */
+    void increaseKey(Handle handle, const T& key);
+
+    /** 把句柄对应的元素替换为一个优先级不高于它的新 key */
+    void decreaseKey(Handle handle, const T& key);
+
+    /** 把句柄对应的元素替换为任意的新 key */
+    void update(Handle handle, const T& key);
+
+    /** 删除句柄对应的元素 */
+    void erase(Handle handle);
+
+    /** 清除堆的所有元素 */
+    void clear();
+
+    /** 检查这个堆是否是空堆 */
+    [[nodiscard]] bool empty() const;
+
+    /** 返回队列长度 */
+    [[nodiscard]] size_t size() const;
+
+private:
+    /**
+     * 节点：child 指向最左边的子节点，sibling 指向右边的兄弟，
+     * prev 指向左边的兄弟，如果自己就是最左边的子节点则指向父节点，根节点的 prev 为空。
+     */
+    struct Node {
+        explicit Node(const T& key) : key(key), child(nullptr), sibling(nullptr), prev(nullptr) { }
+
+        T key;
+        Node* child;
+        Node* sibling;
+        Node* prev;
+    };
+
+    Node* root;
+    size_t count;
+    NodePool<Node> pool;
+    [[no_unique_address]] Compare compare;
+
+    /** 两趟配对过程中复用的暂存区，避免每次 pop 都申请内存 */
+    std::vector<Node*> pairingBuffer;
+
+    /** 合并两棵（根节点没有兄弟的）树，返回新的根 */
+    Node* link(Node* lhs, Node* rhs);
+
+    /** 把 node 连同它的子树从所在的兄弟链表上摘下来，node 不能是根 */
+    void cut(Node* node);
+
+    /** 把 firstChild 开始的一串兄弟节点两趟配对成一棵树 */
+    Node* mergePairs(Node* firstChild);
+
+    /** 把 node 从堆中摘下来（不回收），它的子树并回堆中 */
+    void detach(Node* node);
+
+    /** 析构 subtreeRoot 为根的整棵子树的所有节点 */
+    void destroySubtree(Node* subtreeRoot);
+
+    /** 比较两个 key，返回 true 当且仅当 lhs 的优先级低于 rhs */
+    [[nodiscard]] bool comparePriorityLessThan(const T& lhs, const T& rhs) const;
+};
+
+template <typename T, typename Compare>
+PairingHeap<T, Compare>::PairingHeap(const Compare &_compare)
+: root(nullptr), count(0), pool(), compare(_compare), pairingBuffer() { }
+
+template <typename T, typename Compare>
+PairingHeap<T, Compare>::PairingHeap(PairingHeap &&rhs) noexcept
+: root(std::exchange(rhs.root, nullptr)),
+  count(std::exchange(rhs.count, 0)),
+  pool(std::move(rhs.pool)),
+  compare(std::move(rhs.compare)),
+  pairingBuffer() { }
+
+template <typename T, typename Compare>
+PairingHeap<T, Compare>::~PairingHeap() {
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+        this->destroySubtree(this->root);
+    }
+}
+
+template <typename T, typename Compare>
+typename PairingHeap<T, Compare>::Handle PairingHeap<T, Compare>::insert(const T &key) {
+    Node* node = this->pool.create(key);
+    this->root = this->root ? this->link(this->root, node) : node;
+    ++this->count;
+    return node;
+}
+
+template <typename T, typename Compare>
+T PairingHeap<T, Compare>::top() const {
+    return this->root->key;
+}
+
+template <typename T, typename Compare>
+void PairingHeap<T, Compare>::pop() {
+    if (!this->root) {
+        return;
+    }
+
+    Node* oldRoot = this->root;
+    this->root = this->mergePairs(oldRoot->child);
+    this->pool.destroy(oldRoot);
+    --this->count;
+}
+
+template <typename T, typename Compare>
+void PairingHeap<T, Compare>::meld(PairingHeap &&rhs) {
+    if (this == &rhs) {
+        return;
+    }
+
+    if (rhs.root) {
+        this->root = this->root ? this->link(this->root, rhs.root) : rhs.root;
+    }
+
+    this->count += rhs.count;
+    this->pool.adopt(std::move(rhs.pool));
+    rhs.root = nullptr;
+    rhs.count = 0;
+}
+
+template <typename T, typename Compare>
+const T &PairingHeap<T, Compare>::get(Handle handle) const {
+    return handle->key;
+}
+
+template <typename T, typename Compare>
+void PairingHeap<T, Compare>::increaseKey(Handle handle, const T &key) {
+    assert((!this->comparePriorityLessThan(key, handle->key)));
+    handle->key = key;
+    if (handle != this->root) {
+        this->cut(handle);
+        this->root = this->link(this->root, handle);
+    }
+}
+
+template <typename T, typename Compare>
+void PairingHeap<T, Compare>::decreaseKey(Handle handle, const T &key) {
+    assert((!this->comparePriorityLessThan(handle->key, key)));
+    this->detach(handle);
+    handle->key = key;
+    this->root = this->root ? this->link(this->root, handle) : handle;
+}
+
+template <typename T, typename Compare>
+void PairingHeap<T, Compare>::update(Handle handle, const T &key) {
+    if (this->comparePriorityLessThan(key, handle->key)) {
+        this->decreaseKey(handle, key);
+    } else {
+        this->increaseKey(handle, key);
+    }
+}
+
+template <typename T, typename Compare>
+void PairingHeap<T, Compare>::erase(Handle handle) {
+    this->detach(handle);
+    this->pool.destroy(handle);
+    --this->count;
+}
+
+template <typename T, typename Compare>
+void PairingHeap<T, Compare>::detach(Node *node) {
+    if (node == this->root) {
+        this->root = this->mergePairs(node->child);
+    } else {
+        this->cut(node);
+        if (Node* subtree = this->mergePairs(node->child)) {
+            this->root = this->link(this->root, subtree);
+        }
+    }
+
+    node->child = nullptr;
+}
+
+template <typename T, typename Compare>
+typename PairingHeap<T, Compare>::Node *PairingHeap<T, Compare>::link(Node *lhs, Node *rhs) {
+    if (this->comparePriorityLessThan(lhs->key, rhs->key)) {
+        std::swap(lhs, rhs);
+    }
+
+    // rhs 成为 lhs 最左边的子节点
+    rhs->sibling = lhs->child;
+    if (lhs->child) {
+        lhs->child->prev = rhs;
+    }
+    rhs->prev = lhs;
+    lhs->child = rhs;
+    lhs->sibling = nullptr;
+    lhs->prev = nullptr;
+    return lhs;
+}
+
+template <typename T, typename Compare>
+void PairingHeap<T, Compare>::cut(Node *node) {
+    if (node->prev->child == node) {
+        node->prev->child = node->sibling;
+    } else {
+        node->prev->sibling = node->sibling;
+    }
+
+    if (node->sibling) {
+        node->sibling->prev = node->prev;
+    }
+
+    node->sibling = nullptr;
+    node->prev = nullptr;
+}
+
+template <typename T, typename Compare>
+typename PairingHeap<T, Compare>::Node *PairingHeap<T, Compare>::mergePairs(Node *firstChild) {
+    if (!firstChild) {
+        return nullptr;
+    }
+
+    // 第一趟：从左到右两两合并
+    auto &buffer = this->pairingBuffer;
+    buffer.clear();
+    Node* head = firstChild;
+    while (head) {
+        Node* first = head;
+        Node* second = head->sibling;
+        head = second ? second->sibling : nullptr;
+        first->sibling = nullptr;
+        first->prev = nullptr;
+        if (second) {
+            second->sibling = nullptr;
+            second->prev = nullptr;
+            buffer.push_back(this->link(first, second));
+        } else {
+            buffer.push_back(first);
+        }
+    }
+
+    // 第二趟：从右到左依次合并
+    Node* merged = buffer.back();
+    for (size_t i = buffer.size() - 1; i > 0; --i) {
+        merged = this->link(buffer[i - 1], merged);
+    }
+
+    return merged;
+}
+
+template <typename T, typename Compare>
+void PairingHeap<T, Compare>::destroySubtree(Node *subtreeRoot) {
+    if (!subtreeRoot) {
+        return;
+    }
+
+    // 借用 pairingBuffer 做显式的栈，避免递归过深
+    auto &stack = this->pairingBuffer;
+    stack.clear();
+    stack.push_back(subtreeRoot);
+    while (!stack.empty()) {
+        Node* node = stack.back();
+        stack.pop_back();
+        for (Node* child = node->child; child; child = child->sibling) {
+            stack.push_back(child);
+        }
+        this->pool.destroy(node);
+    }
+}
+
+template <typename T, typename Compare>
+bool PairingHeap<T, Compare>::comparePriorityLessThan(const T &lhs, const T &rhs) const {
+    return this->compare(lhs, rhs);
+}
+
+template <typename T, typename Compare>
+void PairingHeap<T, Compare>::clear() {
+    this->destroySubtree(this->root);
+    this->root = nullptr;
+    this->count = 0;
+}
+
+template <typename T, typename Compare>
+bool PairingHeap<T, Compare>::empty() const {
+    return this->root == nullptr;
+}
+
+template <typename T, typename Compare>
+size_t PairingHeap<T, Compare>::size() const {
+    return this->count;
+}
+
+#endif //DATASTRUCTUREIMPLEMENTATIONS_PAIRINGHEAP_HPP
@@ -0,0 +1,276 @@
+#ifndef DATASTRUCTUREIMPLEMENTATIONS_PERSISTENTHEAP_HPP
+#define DATASTRUCTUREIMPLEMENTATIONS_PERSISTENTHEAP_HPP
+
+#include <cassert>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+#include "NodePool.hpp"
+
+/**
+ * 可持久化的左偏堆：每一个 PersistentHeap 对象都是一个不可变的"版本"，
+ * insert / pop / meld 不修改原来的版本，而是返回一个新版本，新旧版本共享没有被改动的子树。
+ * - 复制一个版本（即打快照）: O(1), 只是给根节点的引用计数加一
+ * - insert / pop / meld: O(log n), 只复制沿途右脊上的 O(log n) 个节点
+ * - top: O(1)
+ * 所以试探性的调度可以随手保存一个版本，试完之后丢掉新版本就回滚了。
+ *
+ * 左偏堆：每个节点的 rank 是它到最近的空子树的距离，左子节点的 rank 不小于右子节点，
+ * 于是右脊的长度不超过 log2(n + 1), 合并只沿着右脊进行。
+ * Compare 的约定和 Heap 一致。
+ *
+ * 节点从 Arena 中分配：Arena 里是一个 NodePool, 节点自带（非原子的）引用计数，
+ * 所以没有每个节点一份的 std::shared_ptr 控制块，也不是线程安全的。
+ * 同一个 Arena 上的版本之间才能 meld, Arena 必须比它上面的所有版本活得更久。
+ */
+template <typename T, typename Compare = std::less<>>
+class PersistentHeap {
+    struct Node;
+
+public:
+    /** 节点的分配器，被同一组版本共享 */
+    class Arena {
+    public:
+        Arena() : pool(), releaseStack(), liveNodes(0) { }
+
+        Arena(const Arena& rhs) = delete;
+
+        ~Arena() {
+            assert((this->liveNodes == 0));
+        }
+
+        /** 目前活着的节点个数，所有版本共享的节点只算一次 */
+        [[nodiscard]] size_t nodeCount() const {
+            return this->liveNodes;
+        }
+
+    private:
+        friend class PersistentHeap;
+
+        NodePool<Node> pool;
+
+        /** 释放节点时复用的显式栈，左脊可能很长，不能递归 */
+        std::vector<Node*> releaseStack;
+
+        size_t liveNodes;
+    };
+
+    /** 在 arena 上构造一个空堆，可以指定 key 的排序准则 */
+    explicit PersistentHeap(Arena& arena, const Compare& compare = Compare());
+
+    /** 复制就是打快照，O(1) */
+    PersistentHeap(const PersistentHeap& rhs) noexcept;
+
+    PersistentHeap(PersistentHeap&& rhs) noexcept;
+
+    PersistentHeap& operator=(const PersistentHeap& rhs) noexcept;
+
+    PersistentHeap& operator=(PersistentHeap&& rhs) noexcept;
+
+    ~PersistentHeap();
+
+    /** 返回插入了 key 之后的新版本 */
+    [[nodiscard]] PersistentHeap insert(const T& key) const;
+
+    /** 返回弹出了堆顶之后的新版本，空堆弹出之后仍是空堆 */
+    [[nodiscard]] PersistentHeap pop() const;
+
+    /** 返回和 rhs 合并之后的新版本，rhs 必须来自同一个 Arena */
+    [[nodiscard]] PersistentHeap meld(const PersistentHeap& rhs) const;
+
+    /** 查看堆顶部的元素，堆不得为空 */
+    [[nodiscard]] const T& top() const;
+
+    /** 检查这个版本是否是空堆 */
+    [[nodiscard]] bool empty() const;
+
+    /** 这个版本中元素的个数 */
+    [[nodiscard]] size_t size() const;
+
+private:
+    struct Node {
+        Node(const T& key, Node* left, Node* right, uint32_t rank)
+        : key(key), left(left), right(right), rank(rank), refCount(1) { }
+
+        T key;
+        Node* left;
+        Node* right;
+        uint32_t rank;
+        uint32_t refCount;
+    };
+
+    Arena* arena;
+    Node* root;
+    size_t count;
+    [[no_unique_address]] Compare compare;
+
+    /** 直接以 root 为根构造一个版本，root 的一个引用转交给新版本 */
+    PersistentHeap(Arena* arena, Node* root, size_t count, const Compare& compare);
+
+    static uint32_t rankOf(const Node* node) noexcept;
+
+    static Node* retain(Node* node) noexcept;
+
+    /** 引用计数减一，降到零的节点被析构，并继续释放它的子节点 */
+    void release(Node* node) const;
+
+    /** 新建一个节点，取得 left 和 right 的各一个引用，并按照 rank 摆好左右 */
+    Node* makeNode(const T& key, Node* left, Node* right) const;
+
+    /** 合并两棵树，不修改它们，返回的根带有一个引用 */
+    Node* merge(Node* lhs, Node* rhs) const;
+};
+
+template <typename T, typename Compare>
+PersistentHeap<T, Compare>::PersistentHeap(Arena &_arena, const Compare &_compare)
+: arena(&_arena), root(nullptr), count(0), compare(_compare) { }
+
+template <typename T, typename Compare>
+PersistentHeap<T, Compare>::PersistentHeap(Arena *_arena, Node *_root, size_t _count, const Compare &_compare)
+: arena(_arena), root(_root), count(_count), compare(_compare) { }
+
+template <typename T, typename Compare>
+PersistentHeap<T, Compare>::PersistentHeap(const PersistentHeap &rhs) noexcept
+: arena(rhs.arena), root(retain(rhs.root)), count(rhs.count), compare(rhs.compare) { }
+
+template <typename T, typename Compare>
+PersistentHeap<T, Compare>::PersistentHeap(PersistentHeap &&rhs) noexcept
+: arena(rhs.arena), root(std::exchange(rhs.root, nullptr)), count(std::exchange(rhs.count, 0)), compare(std::move(rhs.compare)) { }
+
+template <typename T, typename Compare>
+PersistentHeap<T, Compare> &PersistentHeap<T, Compare>::operator=(const PersistentHeap &rhs) noexcept {
+    // 先加后减，自赋值也是安全的
+    Node* newRoot = retain(rhs.root);
+    this->release(this->root);
+    this->arena = rhs.arena;
+    this->root = newRoot;
+    this->count = rhs.count;
+    this->compare = rhs.compare;
+    return *this;
+}
+
+template <typename T, typename Compare>
+PersistentHeap<T, Compare> &PersistentHeap<T, Compare>::operator=(PersistentHeap &&rhs) noexcept {
+    if (this != &rhs) {
+        this->release(this->root);
+        this->arena = rhs.arena;
+        this->root = std::exchange(rhs.root, nullptr);
+        this->count = std::exchange(rhs.count, 0);
+        this->compare = std::move(rhs.compare);
+    }
+
+    return *this;
+}
+
+template <typename T, typename Compare>
+PersistentHeap<T, Compare>::~PersistentHeap() {
+    this->release(this->root);
+}
+
+template <typename T, typename Compare>
+uint32_t PersistentHeap<T, Compare>::rankOf(const Node *node) noexcept {
+    return node ? node->rank : 0;
+}
+
+template <typename T, typename Compare>
+typename PersistentHeap<T, Compare>::Node *PersistentHeap<T, Compare>::retain(Node *node) noexcept {
+    if (node) {
+        ++node->refCount;
+    }
+
+    return node;
+}
+
+template <typename T, typename Compare>
+void PersistentHeap<T, Compare>::release(Node *node) const {
+    if (!node || --node->refCount > 0) {
+        return;
+    }
+
+    auto &stack = this->arena->releaseStack;
+    stack.push_back(node);
+    while (!stack.empty()) {
+        Node* dead = stack.back();
+        stack.pop_back();
+        for (Node* child : { dead->left, dead->right }) {
+            if (child && --child->refCount == 0) {
+                stack.push_back(child);
+            }
+        }
+        this->arena->pool.destroy(dead);
+        --this->arena->liveNodes;
+    }
+}
+
+template <typename T, typename Compare>
+typename PersistentHeap<T, Compare>::Node *PersistentHeap<T, Compare>::makeNode(const T &key, Node *left, Node *right) const {
+    if (rankOf(left) < rankOf(right)) {
+        std::swap(left, right);
+    }
+
+    ++this->arena->liveNodes;
+    return this->arena->pool.create(key, left, right, rankOf(right) + 1);
+}
+
+template <typename T, typename Compare>
+typename PersistentHeap<T, Compare>::Node *PersistentHeap<T, Compare>::merge(Node *lhs, Node *rhs) const {
+    if (!lhs) {
+        return retain(rhs);
+    }
+    if (!rhs) {
+        return retain(lhs);
+    }
+
+    if (this->compare(lhs->key, rhs->key)) {
+        std::swap(lhs, rhs);
+    }
+
+    // lhs 的根保留下来，它的右子树和 rhs 合并；沿途的节点都是新复制的，原来的树不变
+    Node* mergedRight = this->merge(lhs->right, rhs);
+    return this->makeNode(lhs->key, retain(lhs->left), mergedRight);
+}
+
+template <typename T, typename Compare>
+PersistentHeap<T, Compare> PersistentHeap<T, Compare>::insert(const T &key) const {
+    ++this->arena->liveNodes;
+    Node* single = this->arena->pool.create(key, nullptr, nullptr, 1);
+    Node* newRoot = this->merge(this->root, single);
+    this->release(single);
+    return PersistentHeap(this->arena, newRoot, this->count + 1, this->compare);
+}
+
+template <typename T, typename Compare>
+PersistentHeap<T, Compare> PersistentHeap<T, Compare>::pop() const {
+    if (!this->root) {
+        return *this;
+    }
+
+    Node* newRoot = this->merge(this->root->left, this->root->right);
+    return PersistentHeap(this->arena, newRoot, this->count - 1, this->compare);
+}
+
+template <typename T, typename Compare>
+PersistentHeap<T, Compare> PersistentHeap<T, Compare>::meld(const PersistentHeap &rhs) const {
+    assert((this->arena == rhs.arena));
+    Node* newRoot = this->merge(this->root, rhs.root);
+    return PersistentHeap(this->arena, newRoot, this->count + rhs.count, this->compare);
+}
+
+template <typename T, typename Compare>
+const T &PersistentHeap<T, Compare>::top() const {
+    assert((this->root));
+    return this->root->key;
+}
+
+template <typename T, typename Compare>
+bool PersistentHeap<T, Compare>::empty() const {
+    return this->root == nullptr;
+}
+
+template <typename T, typename Compare>
+size_t PersistentHeap<T, Compare>::size() const {
+    return this->count;
+}
+
+#endif //DATASTRUCTUREIMPLEMENTATIONS_PERSISTENTHEAP_HPP
@@ -0,0 +1,151 @@
+#ifndef DATASTRUCTUREIMPLEMENTATIONS_RADIXHEAP_HPP
+#define DATASTRUCTUREIMPLEMENTATIONS_RADIXHEAP_HPP
+
+#include <array>
+#include <bit>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <limits>
+#include <utility>
+#include <vector>
+
+/**
+ * 基数堆：单调的整数小顶堆，要求插入的 key 永远不小于最近一次弹出的 key（Dijkstra、事件模拟的时间戳都满足这一点）。
+ *
+ * 主要思路：
+ * 记 last 为最近一次弹出的 key, 把 key 放进编号为 bit_width(key ^ last) 的桶里，
+ * 即按照 key 和 last 的最高不同位分桶，0 号桶里的 key 都等于 last.
+ * 0 号桶空了以后，找到编号最小的非空桶，取出其中最小的 key 作为新的 last, 再把这个桶里的元素重新分桶，
+ * 由于它们和新的 last 的最高不同位一定更低，每个元素最多被重新分桶 bits(Key) 次，
+ * 所以 insert 是 O(1), pop 是均摊 O(log C), 其中 C 是 key 的取值范围，整个过程不需要任何比较器。
+ */
+template <std::unsigned_integral Key, typename Value>
+class RadixHeap {
+public:
+    RadixHeap() : buckets(), last(0), count(0) { }
+
+    /** 插入一个元素，key 不得小于最近一次弹出的 key */
+    void insert(Key key, const Value& value);
+
+    /** 查看堆顶部的 key, 即当前最小的 key */
+    [[nodiscard]] Key topKey() const;
+
+    /** 查看堆顶部的 value */
+    [[nodiscard]] const Value& topValue() const;
+
+    /** 弹出堆顶部的元素 */
+    void pop();
+
+    /** 清除堆的所有元素，单调性的约束也随之重置 */
+    void clear();
+
+    /** 检查这个堆是否是空堆 */
+    [[nodiscard]] bool empty() const;
+
+    /** 返回队列长度 */
+    [[nodiscard]] size_t size() const;
+
+private:
+    static constexpr size_t bucketCount = std::numeric_limits<Key>::digits + 1;
+
+    /**
+     * 桶，0 号桶中元素的 key 都等于 last.
+     * 重新分桶是在查看或者弹出堆顶时才惰性地进行的，否则 last 会提前越过最近一次弹出的 key,
+     * 使得介于两者之间的合法插入被拒绝，所以桶和 last 是 mutable 的。
+     */
+    mutable std::array<std::vector<std::pair<Key, Value>>, bucketCount> buckets;
+
+    /** 最近一次弹出的 key, 或者最近一次重新分桶选出的 last */
+    mutable Key last;
+
+    size_t count;
+
+    /** key 应该放在几号桶 */
+    [[nodiscard]] size_t bucketOf(Key key) const;
+
+    /** 在 0 号桶为空时，从编号最小的非空桶中找出新的 last, 并把该桶重新分桶 */
+    void pull() const;
+};
+
+template <std::unsigned_integral Key, typename Value>
+size_t RadixHeap<Key, Value>::bucketOf(Key key) const {
+    return static_cast<size_t>(std::bit_width(static_cast<Key>(key ^ this->last)));
+}
+
+template <std::unsigned_integral Key, typename Value>
+void RadixHeap<Key, Value>::insert(Key key, const Value &value) {
+    assert((key >= this->last));
+    this->buckets[this->bucketOf(key)].emplace_back(key, value);
+    ++this->count;
+}
+
+template <std::unsigned_integral Key, typename Value>
+Key RadixHeap<Key, Value>::topKey() const {
+    this->pull();
+    return this->buckets[0].back().first;
+}
+
+template <std::unsigned_integral Key, typename Value>
+const Value &RadixHeap<Key, Value>::topValue() const {
+    this->pull();
+    return this->buckets[0].back().second;
+}
+
+template <std::unsigned_integral Key, typename Value>
+void RadixHeap<Key, Value>::pop() {
+    if (this->count == 0) {
+        return;
+    }
+
+    this->pull();
+    this->buckets[0].pop_back();
+    --this->count;
+}
+
+template <std::unsigned_integral Key, typename Value>
+void RadixHeap<Key, Value>::pull() const {
+    if (!this->buckets[0].empty()) {
+        return;
+    }
+
+    size_t bucketIdx = 1;
+    while (this->buckets[bucketIdx].empty()) {
+        ++bucketIdx;
+    }
+
+    auto &source = this->buckets[bucketIdx];
+    Key newLast = source[0].first;
+    for (const auto &entry : source) {
+        if (entry.first < newLast) {
+            newLast = entry.first;
+        }
+    }
+
+    this->last = newLast;
+    for (auto &entry : source) {
+        this->buckets[this->bucketOf(entry.first)].push_back(std::move(entry));
+    }
+    source.clear();
+}
+
+template <std::unsigned_integral Key, typename Value>
+void RadixHeap<Key, Value>::clear() {
+    for (auto &bucket : this->buckets) {
+        bucket.clear();
+    }
+    this->last = 0;
+    this->count = 0;
+}
+
+template <std::unsigned_integral Key, typename Value>
+bool RadixHeap<Key, Value>::empty() const {
+    return this->count == 0;
+}
+
+template <std::unsigned_integral Key, typename Value>
+size_t RadixHeap<Key, Value>::size() const {
+    return this->count;
+}
+
+#endif //DATASTRUCTUREIMPLEMENTATIONS_RADIXHEAP_HPP
@@ -0,0 +1,306 @@
+#ifndef DATASTRUCTUREIMPLEMENTATIONS_STABLEHEAP_HPP
+#define DATASTRUCTUREIMPLEMENTATIONS_STABLEHEAP_HPP
+
+#include <cassert>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "Heap.hpp"
+
+/**
+ * 稳定的堆：优先级相同的元素按照插入的先后顺序（先进先出）弹出，其余的行为和 Heap<T, Compare> 一致。
+ *
+ * 主要思路：
+ * 每次插入时给元素盖一个单调递增的序号，序号和元素放在同一个存储单元里（没有额外的间接访问），
+ * 比较时先比 key, key 相同再比序号，序号小的优先级高。序号是 64 位的，实际上不会用完。
+ */
+template <typename T, typename Compare = std::less<>>
+class StableHeap {
+public:
+    /** 构造一个空堆，可以指定 key 的排序准则 */
+    explicit StableHeap(const Compare& compare = Compare());
+
+    /** 插入一个元素 */
+    void insert(const T& key);
+
+    /** 以移动的方式插入一个元素 */
+    void insert(T&& key);
+
+    /** 用 args 在存储区域的末尾直接构造一个元素 */
+    template <typename... Args>
+    void emplace(Args&&... args);
+
+    /** 查看堆顶部的元素 */
+    T top() const;
+
+    /** 查看堆顶部的元素，返回常量引用，引用在堆下一次被修改之前有效 */
+    const T& topRef() const;
+
+    /** 弹出堆顶部的元素 */
+    void pop();
+
+    /** 弹出堆顶部的元素并把它移动出来返回，堆不得为空 */
+    T extract();
+
+    /** 清除堆的所有元素，序号不重置 */
+    void clear();
+
+    /** 检查这个堆是否是空堆 */
+    [[nodiscard]] bool empty() const;
+
+    /** 返回队列长度 */
+    [[nodiscard]] size_t size() const;
+
+private:
+    struct Entry {
+        template <typename... Args>
+        explicit Entry(uint64_t sequence, Args&&... args) : key(std::forward<Args>(args)...), sequence(sequence) { }
+
+        T key;
+        uint64_t sequence;
+    };
+
+    /** 先比 key, key 相同时序号大（插入得晚）的优先级低 */
+    struct EntryCompare {
+        [[no_unique_address]] Compare compare;
+
+        bool operator()(const Entry& lhs, const Entry& rhs) const {
+            if (this->compare(lhs.key, rhs.key)) {
+                return true;
+            }
+            if (this->compare(rhs.key, lhs.key)) {
+                return false;
+            }
+            return lhs.sequence > rhs.sequence;
+        }
+    };
+
+    Heap<Entry, EntryCompare> heap;
+    uint64_t nextSequence;
+};
+
+template <typename T, typename Compare>
+StableHeap<T, Compare>::StableHeap(const Compare &_compare) : heap(EntryCompare { _compare }), nextSequence(0) { }
+
+template <typename T, typename Compare>
+void StableHeap<T, Compare>::insert(const T &key) {
+    this->heap.emplace(this->nextSequence++, key);
+}
+
+template <typename T, typename Compare>
+void StableHeap<T, Compare>::insert(T &&key) {
+    this->heap.emplace(this->nextSequence++, std::move(key));
+}
+
+template <typename T, typename Compare>
+template <typename... Args>
+void StableHeap<T, Compare>::emplace(Args &&...args) {
+    this->heap.emplace(this->nextSequence++, std::forward<Args>(args)...);
+}
+
+template <typename T, typename Compare>
+T StableHeap<T, Compare>::top() const {
+    return this->heap.topRef().key;
+}
+
+template <typename T, typename Compare>
+const T &StableHeap<T, Compare>::topRef() const {
+    return this->heap.topRef().key;
+}
+
+template <typename T, typename Compare>
+void StableHeap<T, Compare>::pop() {
+    this->heap.pop();
+}
+
+template <typename T, typename Compare>
+T StableHeap<T, Compare>::extract() {
+    return std::move(this->heap.extract().key);
+}
+
+template <typename T, typename Compare>
+void StableHeap<T, Compare>::clear() {
+    this->heap.clear();
+}
+
+template <typename T, typename Compare>
+bool StableHeap<T, Compare>::empty() const {
+    return this->heap.empty();
+}
+
+template <typename T, typename Compare>
+size_t StableHeap<T, Compare>::size() const {
+    return this->heap.size();
+}
+
+/**
+ * 小整数优先级的稳定堆：优先级和序号打包进同一个 uint64_t, 每次比较只是一条整数比较指令。
+ *
+ * 主要思路：
+ * 高 PriorityBits 位放优先级，低 64 - PriorityBits 位放"反转"过的序号（seqMask - 序号），
+ * 于是打包后的整数越大越应该先弹出：优先级高的在前，优先级相同时序号小（插入得早）的在前。
+ * Compare 只能是 std::less<>（优先级数值大的先出）或者 std::greater<>（数值小的先出），
+ * 后者把优先级也反转之后再打包，内部始终是同一个以 uint64_t 比较的大顶堆。
+ * Value 和打包的整数放在同一个元素里，比较时不会访问它。
+ *
+ * 序号用完时（PriorityBits = 16 时是 2^48 次插入），按当前的出队顺序重新编号，相对顺序不变。
+ */
+template <typename Value, unsigned PriorityBits = 16, typename Compare = std::less<>>
+class PackedStableHeap {
+    static_assert(PriorityBits >= 1 && PriorityBits <= 32, "PackedStableHeap: PriorityBits must be in [1, 32]");
+    static_assert(std::is_same_v<Compare, std::less<>> || std::is_same_v<Compare, std::greater<>>,
+                  "PackedStableHeap: Compare must be std::less<> or std::greater<>");
+
+public:
+    /** 优先级的取值范围是 [0, maxPriority] */
+    static constexpr uint64_t maxPriority = (uint64_t(1) << PriorityBits) - 1;
+
+    PackedStableHeap() : heap(), nextSequence(0) { }
+
+    /** 插入一个元素 */
+    void insert(uint64_t priority, const Value& value);
+
+    /** 以移动的方式插入一个元素 */
+    void insert(uint64_t priority, Value&& value);
+
+    /** 堆顶部元素的优先级 */
+    [[nodiscard]] uint64_t topPriority() const;
+
+    /** 堆顶部元素的值 */
+    [[nodiscard]] const Value& topValue() const;
+
+    /** 弹出堆顶部的元素 */
+    void pop();
+
+    /** 弹出堆顶部的元素，把它的值移动出来返回，堆不得为空 */
+    Value extract();
+
+    /** 清除堆的所有元素 */
+    void clear();
+
+    /** 检查这个堆是否是空堆 */
+    [[nodiscard]] bool empty() const;
+
+    /** 返回队列长度 */
+    [[nodiscard]] size_t size() const;
+
+private:
+    static constexpr unsigned sequenceBits = 64 - PriorityBits;
+    static constexpr uint64_t sequenceMask = (uint64_t(1) << sequenceBits) - 1;
+
+    struct Entry {
+        uint64_t packed;
+        Value value;
+    };
+
+    /** 只比较打包后的整数 */
+    struct PackedLess {
+        bool operator()(const Entry& lhs, const Entry& rhs) const {
+            return lhs.packed < rhs.packed;
+        }
+    };
+
+    Heap<Entry, PackedLess> heap;
+    uint64_t nextSequence;
+
+    static uint64_t pack(uint64_t priority, uint64_t sequence);
+
+    /** 取下一个序号，用完时先重新编号 */
+    uint64_t takeSequence();
+
+    /** 按出队顺序把现有的元素重新编号为 0, 1, 2, ... */
+    void renumber();
+};
+
+template <typename Value, unsigned PriorityBits, typename Compare>
+uint64_t PackedStableHeap<Value, PriorityBits, Compare>::pack(uint64_t priority, uint64_t sequence) {
+    assert((priority <= maxPriority));
+    if constexpr (std::is_same_v<Compare, std::greater<>>) {
+        priority = maxPriority - priority;
+    }
+
+    return (priority << sequenceBits) | (sequenceMask - sequence);
+}
+
+template <typename Value, unsigned PriorityBits, typename Compare>
+uint64_t PackedStableHeap<Value, PriorityBits, Compare>::takeSequence() {
+    if (this->nextSequence > sequenceMask) {
+        this->renumber();
+    }
+
+    return this->nextSequence++;
+}
+
+template <typename Value, unsigned PriorityBits, typename Compare>
+void PackedStableHeap<Value, PriorityBits, Compare>::renumber() {
+    std::vector<Entry> entries;
+    entries.reserve(this->heap.size());
+    this->heap.popK(this->heap.size(), std::back_inserter(entries));
+
+    // entries 已经是出队顺序，按这个顺序重新编号不会改变任何两个元素的先后
+    const uint64_t priorityMask = ~sequenceMask;
+    for (size_t i = 0; i < entries.size(); ++i) {
+        entries[i].packed = (entries[i].packed & priorityMask) | (sequenceMask - i);
+    }
+
+    this->nextSequence = entries.size();
+    this->heap.pushBulk(std::move(entries), BulkInsertStrategy::Rebuild);
+}
+
+template <typename Value, unsigned PriorityBits, typename Compare>
+void PackedStableHeap<Value, PriorityBits, Compare>::insert(uint64_t priority, const Value &value) {
+    uint64_t sequence = this->takeSequence();
+    this->heap.insert(Entry { pack(priority, sequence), value });
+}
+
+template <typename Value, unsigned PriorityBits, typename Compare>
+void PackedStableHeap<Value, PriorityBits, Compare>::insert(uint64_t priority, Value &&value) {
+    uint64_t sequence = this->takeSequence();
+    this->heap.insert(Entry { pack(priority, sequence), std::move(value) });
+}
+
+template <typename Value, unsigned PriorityBits, typename Compare>
+uint64_t PackedStableHeap<Value, PriorityBits, Compare>::topPriority() const {
+    uint64_t priority = this->heap.topRef().packed >> sequenceBits;
+    if constexpr (std::is_same_v<Compare, std::greater<>>) {
+        priority = maxPriority - priority;
+    }
+
+    return priority;
+}
+
+template <typename Value, unsigned PriorityBits, typename Compare>
+const Value &PackedStableHeap<Value, PriorityBits, Compare>::topValue() const {
+    return this->heap.topRef().value;
+}
+
+template <typename Value, unsigned PriorityBits, typename Compare>
+void PackedStableHeap<Value, PriorityBits, Compare>::pop() {
+    this->heap.pop();
+}
+
+template <typename Value, unsigned PriorityBits, typename Compare>
+Value PackedStableHeap<Value, PriorityBits, Compare>::extract() {
+    return std::move(this->heap.extract().value);
+}
+
+template <typename Value, unsigned PriorityBits, typename Compare>
+void PackedStableHeap<Value, PriorityBits, Compare>::clear() {
+    this->heap.clear();
+    this->nextSequence = 0;
+}
+
+template <typename Value, unsigned PriorityBits, typename Compare>
+bool PackedStableHeap<Value, PriorityBits, Compare>::empty() const {
+    return this->heap.empty();
+}
+
+template <typename Value, unsigned PriorityBits, typename Compare>
+size_t PackedStableHeap<Value, PriorityBits, Compare>::size() const {
+    return this->heap.size();
+}
+
+#endif //DATASTRUCTUREIMPLEMENTATIONS_STABLEHEAP_HPP
@@ -0,0 +1,191 @@
+#ifndef DATASTRUCTUREIMPLEMENTATIONS_TOPK_HPP
+#define DATASTRUCTUREIMPLEMENTATIONS_TOPK_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <functional>
+#include <iterator>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "Heap.hpp"
+
+#if __has_include(<experimental/simd>)
+#include <experimental/simd>
+#endif
+
+/**
+ * 流式的 Top-K 累加器：在源源不断的输入中保留优先级最高的 K 个元素，Compare 的约定和 Heap 一致。
+ *
+ * 主要思路：
+ * 内部是一个把 Compare 反过来的 Heap, 堆顶就是已保留的 K 个元素中最差的那个，即"门槛"，
+ * 新元素不比门槛好就直接丢弃，否则用它替换堆顶并下沉。
+ * 输入量远大于 K 时绝大多数元素都会被丢弃，所以真正要优化的是"丢弃"的代价：
+ * pushRange 把输入按 blockSize 个一组，先检查整组里有没有比门槛好的元素，整组都不合格时一次跳过，只有含有候选的组才逐个处理。
+ * 对于算术类型和 std::less / std::greater, 这个检查用 std::experimental::simd 写成显式的向量比较
+ * （GCC 不会自动向量化这种提前结束的归约）；其他情况以及没有 <experimental/simd> 的标准库用一个没有分支的标量循环。
+ */
+template <typename T, size_t K, typename Compare = std::less<>>
+class TopK {
+    static_assert(K > 0, "TopK requires K > 0");
+
+public:
+    /** 预过滤时一组的元素个数 */
+    static constexpr size_t blockSize = 16;
+
+    /** 构造一个空的累加器，可以指定 key 的排序准则 */
+    explicit TopK(const Compare& compare = Compare());
+
+    /** 处理一个新元素 */
+    void push(const T& key);
+
+    /** 处理一段连续存放的元素，整组不合格的元素会被成批地跳过 */
+    template <std::ranges::contiguous_range Range>
+    void pushRange(const Range& range);
+
+    /** 当前的门槛，即已保留的元素中优先级最低的那个，累加器不得为空 */
+    [[nodiscard]] const T& threshold() const;
+
+    /** 是否已经保留了 K 个元素，此后新元素必须比门槛好才会被保留 */
+    [[nodiscard]] bool full() const;
+
+    /** 已保留的元素个数，不超过 K */
+    [[nodiscard]] size_t size() const;
+
+    /** 按优先级从高到低取出已保留的所有元素，之后累加器变为空 */
+    std::vector<T> extractSorted();
+
+    /** 清除已保留的所有元素 */
+    void clear();
+
+private:
+    /** 把 Compare 反过来，使得内部堆的堆顶是优先级最低的元素 */
+    struct ReversedCompare {
+        [[no_unique_address]] Compare compare;
+
+        bool operator()(const T& lhs, const T& rhs) const {
+            return this->compare(rhs, lhs);
+        }
+    };
+
+    Heap<T, ReversedCompare> heap;
+    [[no_unique_address]] Compare compare;
+
+    /** Compare 是不是 std::less / std::greater, 而 T 是算术类型，这时可以用向量比较代替逐个调用 compare */
+    static constexpr bool vectorizable = std::is_arithmetic_v<T> && (
+        std::is_same_v<Compare, std::less<>> || std::is_same_v<Compare, std::less<T>> ||
+        std::is_same_v<Compare, std::greater<>> || std::is_same_v<Compare, std::greater<T>>
+    );
+
+    /** 检查 [first, first + blockSize) 中是否有比 bar 更好的元素，循环中没有分支 */
+    [[nodiscard]] bool blockHasCandidate(const T* first, const T& bar) const;
+};
+
+template <typename T, size_t K, typename Compare>
+TopK<T, K, Compare>::TopK(const Compare &_compare) : heap(ReversedCompare { _compare }), compare(_compare) { }
+
+template <typename T, size_t K, typename Compare>
+void TopK<T, K, Compare>::push(const T &key) {
+    if (this->heap.size() < K) {
+        this->heap.insert(key);
+    } else if (this->compare(this->heap.topRef(), key)) {
+        this->heap.replaceTop(key);
+    }
+}
+
+template <typename T, size_t K, typename Compare>
+bool TopK<T, K, Compare>::blockHasCandidate(const T *first, const T &bar) const {
+#if defined(__cpp_lib_experimental_parallel_simd)
+    // native_simd<T> 只对算术类型有定义，必须先判断 vectorizable, 否则其他 T 会编译失败
+    if constexpr (vectorizable) {
+        namespace stdx = std::experimental;
+        using Lanes = stdx::native_simd<T>;
+        if constexpr (blockSize % Lanes::size() == 0) {
+            // 逐段比较，掩码按位或累积，最后一次性判断
+            constexpr bool greater = std::is_same_v<Compare, std::greater<>> || std::is_same_v<Compare, std::greater<T>>;
+            const Lanes bars (bar);
+            typename Lanes::mask_type hits (false);
+            for (size_t i = 0; i < blockSize; i += Lanes::size()) {
+                const Lanes keys (first + i, stdx::element_aligned);
+                if constexpr (greater) {
+                    hits |= bars > keys;
+                } else {
+                    hits |= bars < keys;
+                }
+            }
+
+            return stdx::any_of(hits);
+        }
+    }
+#endif
+
+    // 用按位或累积而不是提前返回，这样循环体里没有分支，才能被向量化
+    unsigned hits = 0;
+    for (size_t i = 0; i < blockSize; ++i) {
+        hits |= static_cast<unsigned>(this->compare(bar, first[i]));
+    }
+
+    return hits != 0;
+}
+
+template <typename T, size_t K, typename Compare>
+template <std::ranges::contiguous_range Range>
+void TopK<T, K, Compare>::pushRange(const Range &range) {
+    const T* first = std::ranges::data(range);
+    const T* last = first + std::ranges::size(range);
+
+    // 先把堆填满，此前还没有门槛可言
+    while (first != last && this->heap.size() < K) {
+        this->heap.insert(*first);
+        ++first;
+    }
+
+    while (last - first >= static_cast<std::ptrdiff_t>(blockSize)) {
+        // 门槛复制一份，否则编译器要担心 heap 在循环中被修改，无法向量化
+        const T bar = this->heap.topRef();
+        if (this->blockHasCandidate(first, bar)) {
+            for (const T* it = first; it != first + blockSize; ++it) {
+                this->push(*it);
+            }
+        }
+        first += blockSize;
+    }
+
+    for (; first != last; ++first) {
+        this->push(*first);
+    }
+}
+
+template <typename T, size_t K, typename Compare>
+const T &TopK<T, K, Compare>::threshold() const {
+    assert((!this->heap.empty()));
+    return this->heap.topRef();
+}
+
+template <typename T, size_t K, typename Compare>
+bool TopK<T, K, Compare>::full() const {
+    return this->heap.size() == K;
+}
+
+template <typename T, size_t K, typename Compare>
+size_t TopK<T, K, Compare>::size() const {
+    return this->heap.size();
+}
+
+template <typename T, size_t K, typename Compare>
+std::vector<T> TopK<T, K, Compare>::extractSorted() {
+    // 内部堆按从差到好的顺序弹出，反转之后就是从好到差
+    std::vector<T> result;
+    result.reserve(this->heap.size());
+    this->heap.popK(this->heap.size(), std::back_inserter(result));
+    std::reverse(result.begin(), result.end());
+    return result;
+}
+
+template <typename T, size_t K, typename Compare>
+void TopK<T, K, Compare>::clear() {
+    this->heap.clear();
+}
+
+#endif //DATASTRUCTUREIMPLEMENTATIONS_TOPK_HPP
@@ -0,0 +1,254 @@
+#ifndef DATASTRUCTUREIMPLEMENTATIONS_TIMERWHEEL_HPP
+#define DATASTRUCTUREIMPLEMENTATIONS_TIMERWHEEL_HPP
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <utility>
+#include <vector>
+#include "../DataStructures/AddressableHeap.hpp"
+
+namespace SystemDesign::Timer {
+
+    /** 定时器的编号：低 32 位是节点下标，高 32 位是节点的代数，节点被复用之后旧编号自动失效 */
+    using TimerId = uint64_t;
+
+    /**
+     * 分层时间轮：大量定时器、其中多数在到期前就被取消的场景（比如连接超时）下代替 Heap 做定时器队列。
+     *
+     * 主要思路：
+     * 时间以 tick 为单位，共 LevelCount 层轮子，每层 2^SlotBits 个槽，第 l 层的一个槽代表 2^(SlotBits * l) 个 tick.
+     * 到期时间为 e 的定时器按照 e - now 的大小放进能容纳它的最低一层，槽号是 e 在该层对应的那几位；
+     * 时间每走到第 l 层的一个槽的起点，就把这个槽里的定时器重新分配到更低的层（cascade），
+     * 最终在第 0 层的槽里到期。每个槽是一个侵入式的双向链表，所以：
+     * - schedule / cancel: O(1)
+     * - advance: 每个 tick O(1), 加上到期和重新分配的定时器个数
+     * 超出所有轮子范围（2^(SlotBits * LevelCount) 个 tick 以后）的定时器放在一个 AddressableHeap 里，
+     * 等到它们进入轮子的范围时再移进来，AddressableHeap 支持按句柄删除，所以这部分同样可以取消。
+     *
+     * 节点放在一个 std::vector 里并通过空闲链表复用，定时器本身不单独申请内存。
+     */
+    template <typename Payload, size_t LevelCount = 4, size_t SlotBits = 8>
+    class TimerWheel {
+        static_assert(LevelCount >= 1 && SlotBits >= 1 && SlotBits * LevelCount < 64, "TimerWheel: invalid geometry");
+
+    public:
+        static constexpr size_t slotCount = size_t(1) << SlotBits;
+
+        /** 轮子能直接容纳的最大延迟（不含），更远的定时器先放进溢出堆 */
+        static constexpr uint64_t wheelSpan = uint64_t(1) << (SlotBits * LevelCount);
+
+        /** 从 startTick 开始计时 */
+        explicit TimerWheel(uint64_t startTick = 0) : currentTick(startTick), slots(), nodes(), freeHead(npos), overflow(), liveCount(0) {
+            for (auto &level : this->slots) {
+                level.fill(npos);
+            }
+        }
+
+        /** 不允许复制 */
+        TimerWheel(const TimerWheel& rhs) = delete;
+
+        /**
+         * 安排一个在 delay 个 tick 之后到期的定时器，返回它的编号。
+         * delay 为 0 时按 1 处理，即在下一次 advance 的第一个 tick 到期。
+         */
+        TimerId schedule(uint64_t delay, Payload payload) {
+            uint32_t nodeIdx = this->allocate();
+            Node &node = this->nodes[nodeIdx];
+            node.payload = std::move(payload);
+            node.expiry = this->currentTick + (delay == 0 ? 1 : delay);
+            this->place(nodeIdx);
+            ++this->liveCount;
+            return makeId(nodeIdx, node.generation);
+        }
+
+        /** 取消一个定时器，它已经到期或者已经被取消时返回 false */
+        bool cancel(TimerId id) {
+            uint32_t nodeIdx = static_cast<uint32_t>(id);
+            if (nodeIdx >= this->nodes.size() || this->nodes[nodeIdx].generation != static_cast<uint32_t>(id >> 32)
+                || this->nodes[nodeIdx].level == freeLevel) {
+                return false;
+            }
+
+            this->unlink(nodeIdx);
+            this->release(nodeIdx);
+            --this->liveCount;
+            return true;
+        }
+
+        /**
+         * 时间前进 ticks 个 tick, 每个到期的定时器调用一次 onExpire(TimerId, Payload&).
+         * 回调中可以 schedule 新的定时器，也可以 cancel 其他的定时器。
+         */
+        template <typename Callback>
+        void advance(uint64_t ticks, Callback&& onExpire) {
+            for (uint64_t i = 0; i < ticks; ++i) {
+                ++this->currentTick;
+                this->drainOverflow();
+
+                // 从高层往低层，把走到起点的槽重新分配下去
+                for (size_t level = LevelCount - 1; level > 0; --level) {
+                    if ((this->currentTick & ((uint64_t(1) << (SlotBits * level)) - 1)) == 0) {
+                        this->cascade(level, slotOf(this->currentTick, level));
+                    }
+                }
+
+                // 逐个摘下到期的定时器，而不是整条链表一起摘，这样回调里 cancel 同一个槽里的定时器也是安全的
+                uint32_t &head = this->slots[0][slotOf(this->currentTick, 0)];
+                while (head != npos) {
+                    uint32_t nodeIdx = head;
+                    this->unlink(nodeIdx);
+                    Payload payload = std::move(this->nodes[nodeIdx].payload);
+                    TimerId id = makeId(nodeIdx, this->nodes[nodeIdx].generation);
+                    this->release(nodeIdx);
+                    --this->liveCount;
+                    onExpire(id, payload);
+                }
+            }
+        }
+
+        /** 当前的 tick */
+        [[nodiscard]] uint64_t now() const {
+            return this->currentTick;
+        }
+
+        /** 还没有到期也没有被取消的定时器个数 */
+        [[nodiscard]] size_t size() const {
+            return this->liveCount;
+        }
+
+        /** 是否没有任何待到期的定时器 */
+        [[nodiscard]] bool empty() const {
+            return this->liveCount == 0;
+        }
+
+    private:
+        static constexpr uint32_t npos = std::numeric_limits<uint32_t>::max();
+
+        /** Node::level 取这两个值时分别表示在溢出堆里、在空闲链表里 */
+        static constexpr uint8_t overflowLevel = LevelCount;
+        static constexpr uint8_t freeLevel = LevelCount + 1;
+
+        /** 溢出堆中的元素：到期时间和节点下标，到期时间越早优先级越高 */
+        using OverflowEntry = std::pair<uint64_t, uint32_t>;
+        using OverflowHeap = AddressableHeap<OverflowEntry, std::greater<>>;
+
+        struct Node {
+            Payload payload {};
+            uint64_t expiry = 0;
+
+            /** 所在槽的链表中的前后节点，在空闲链表中只用 next */
+            uint32_t prev = npos;
+            uint32_t next = npos;
+
+            uint32_t generation = 0;
+            uint8_t level = freeLevel;
+
+            /** 在溢出堆中时的句柄 */
+            typename OverflowHeap::Handle overflowHandle = 0;
+        };
+
+        uint64_t currentTick;
+        std::array<std::array<uint32_t, slotCount>, LevelCount> slots;
+        std::vector<Node> nodes;
+        uint32_t freeHead;
+        OverflowHeap overflow;
+        size_t liveCount;
+
+        static TimerId makeId(uint32_t nodeIdx, uint32_t generation) {
+            return (static_cast<uint64_t>(generation) << 32) | nodeIdx;
+        }
+
+        static size_t slotOf(uint64_t tick, size_t level) {
+            return static_cast<size_t>(tick >> (SlotBits * level)) & (slotCount - 1);
+        }
+
+        uint32_t allocate() {
+            if (this->freeHead == npos) {
+                this->nodes.emplace_back();
+                return static_cast<uint32_t>(this->nodes.size() - 1);
+            }
+
+            uint32_t nodeIdx = this->freeHead;
+            this->freeHead = this->nodes[nodeIdx].next;
+            return nodeIdx;
+        }
+
+        /** 回收节点，代数加一使得旧的编号失效 */
+        void release(uint32_t nodeIdx) {
+            Node &node = this->nodes[nodeIdx];
+            node.payload = Payload {};
+            node.level = freeLevel;
+            ++node.generation;
+            node.next = this->freeHead;
+            this->freeHead = nodeIdx;
+        }
+
+        /** 按照到期时间把节点放进合适的层和槽，太远的放进溢出堆 */
+        void place(uint32_t nodeIdx) {
+            Node &node = this->nodes[nodeIdx];
+            uint64_t distance = node.expiry - this->currentTick;
+            if (distance >= wheelSpan) {
+                node.level = overflowLevel;
+                node.overflowHandle = this->overflow.insert({ node.expiry, nodeIdx });
+                return;
+            }
+
+            size_t level = 0;
+            while (distance >= (uint64_t(1) << (SlotBits * (level + 1)))) {
+                ++level;
+            }
+
+            uint32_t &head = this->slots[level][slotOf(node.expiry, level)];
+            node.level = static_cast<uint8_t>(level);
+            node.prev = npos;
+            node.next = head;
+            if (head != npos) {
+                this->nodes[head].prev = nodeIdx;
+            }
+            head = nodeIdx;
+        }
+
+        /** 把节点从所在的槽或者溢出堆中摘下来 */
+        void unlink(uint32_t nodeIdx) {
+            Node &node = this->nodes[nodeIdx];
+            if (node.level == overflowLevel) {
+                this->overflow.erase(node.overflowHandle);
+                return;
+            }
+
+            if (node.prev == npos) {
+                this->slots[node.level][slotOf(node.expiry, node.level)] = node.next;
+            } else {
+                this->nodes[node.prev].next = node.next;
+            }
+
+            if (node.next != npos) {
+                this->nodes[node.next].prev = node.prev;
+            }
+        }
+
+        /** 把第 level 层第 slot 个槽中的定时器重新分配到更低的层 */
+        void cascade(size_t level, size_t slot) {
+            uint32_t nodeIdx = std::exchange(this->slots[level][slot], npos);
+            while (nodeIdx != npos) {
+                uint32_t next = this->nodes[nodeIdx].next;
+                this->place(nodeIdx);
+                nodeIdx = next;
+            }
+        }
+
+        /** 把已经进入轮子范围的溢出定时器移进轮子 */
+        void drainOverflow() {
+            while (!this->overflow.empty() && this->overflow.top().first - this->currentTick < wheelSpan) {
+                uint32_t nodeIdx = this->overflow.top().second;
+                this->overflow.pop();
+                this->place(nodeIdx);
+            }
+        }
+    };
+
+}
+
+#endif //DATASTRUCTUREIMPLEMENTATIONS_TIMERWHEEL_HPP
@@ -0,0 +1,30 @@
+#ifndef DATASTRUCTUREIMPLEMENTATIONS_STOPWATCH_HPP
+#define DATASTRUCTUREIMPLEMENTATIONS_STOPWATCH_HPP
+
+#include <chrono>
+
+namespace Utils {
+
+    /** 简单的计时器，构造时即开始计时，用于 Benchmarks 目录下的各个性能测试 */
+    class Stopwatch {
+    public:
+        Stopwatch() : startedAt(std::chrono::steady_clock::now()) { }
+
+        /** 重新开始计时 */
+        void reset() {
+            this->startedAt = std::chrono::steady_clock::now();
+        }
+
+        /** 返回从开始计时到现在经过的毫秒数 */
+        [[nodiscard]] double elapsedMilliseconds() const {
+            auto elapsed = std::chrono::steady_clock::now() - this->startedAt;
+            return std::chrono::duration<double, std::milli>(elapsed).count();
+        }
+
+    private:
+        std::chrono::steady_clock::time_point startedAt;
+    };
+
+}
+
+#endif //DATASTRUCTUREIMPLEMENTATIONS_STOPWATCH_HPP